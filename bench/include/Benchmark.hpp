@@ -0,0 +1,147 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+  using Clock = std::chrono::steady_clock;
+
+  // Passed to every benchmark body. The body does its setup, then loops with
+  // `while(state.keepRunning()) { ... }`; only the loop is timed.
+  class State {
+  private:
+    std::uint64_t iterations;
+    std::uint64_t remaining;
+    double itemsPerIteration;
+    bool started;
+    Clock::time_point startTime;
+    Clock::time_point stopTime;
+
+  public:
+    explicit State(std::uint64_t iterations)
+      : iterations{iterations}
+      , remaining{iterations}
+      , itemsPerIteration{0}
+      , started{false}
+      , startTime{}
+      , stopTime{}
+    {
+
+    }
+
+    inline bool keepRunning() {
+      if(!started) {
+        started = true;
+        startTime = Clock::now();
+      }
+
+      if(remaining == 0) {
+        stopTime = Clock::now();
+        return false;
+      }
+
+      remaining -= 1;
+      return true;
+    }
+
+    // How many "items" (e.g. emulated instructions) one iteration processes.
+    // Used to report a throughput next to the per-iteration cost.
+    void setItemsPerIteration(double items) {
+      itemsPerIteration = items;
+    }
+
+    std::uint64_t getIterations() const {
+      return iterations;
+    }
+
+    double getItemsPerIteration() const {
+      return itemsPerIteration;
+    }
+
+    double getElapsedNanoseconds() const {
+      return std::chrono::duration<double, std::nano>(stopTime - startTime).count();
+    }
+  };
+
+  using BenchmarkFunction = std::function<void(State &)>;
+
+  struct Benchmark {
+    std::string name;
+    BenchmarkFunction function;
+  };
+
+  struct Result {
+    std::string name;
+    std::uint64_t iterations;
+    std::size_t repetitions;
+    double medianNanoseconds;
+    double meanNanoseconds;
+    double stddevNanoseconds;
+    double minNanoseconds;
+    double itemsPerSecond;
+  };
+
+  struct Options {
+    std::size_t repetitions;
+    double minimumSeconds;
+    std::vector<std::string> filters;
+    std::string outputPath;
+    std::string comparePath;
+
+    Options()
+      : repetitions{5}
+      , minimumSeconds{0.05}
+      , filters{}
+      , outputPath{}
+      , comparePath{}
+    {
+
+    }
+  };
+
+  class Registry {
+  private:
+    std::vector<Benchmark> benchmarks;
+
+  public:
+    void add(const std::string & name, BenchmarkFunction function);
+
+    const std::vector<Benchmark> & getBenchmarks() const {
+      return benchmarks;
+    }
+  };
+
+  // Keeps the compiler from discarding a computation whose result is unused.
+  template <typename T>
+  inline void doNotOptimize(const T & value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void * sink;
+    sink = &value;
+#endif
+  }
+
+  Result run(const Benchmark & benchmark, const Options & options);
+  std::vector<Result> runAll(const Registry & registry, const Options & options, std::ostream & out);
+
+  void printHeader(std::ostream & out);
+  void printResult(const Result & result, std::ostream & out);
+
+  // Saves results (with a description of the build that produced them) so a
+  // later run can be compared against them with printComparison.
+  void writeResults(const std::vector<Result> & results, const std::string & build, std::ostream & out);
+  void printComparison(const std::vector<Result> & results, const std::string & referencePath, std::ostream & out);
+
+  bool parseOptions(const std::vector<std::string> & args, Options & options, std::ostream & err);
+
+  void registerOpcodeBenchmarks(Registry & registry);
+  void registerFunctionBenchmarks(Registry & registry);
+  void registerRomBenchmarks(Registry & registry);
+  void registerAudioBenchmarks(Registry & registry);
+  void registerRecompilerBenchmarks(Registry & registry);
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+#include <iosfwd>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+  // Just enough JSON for benchmark results and baselines: objects, arrays,
+  // strings, numbers, booleans and null. No unicode escapes beyond \uXXXX
+  // for ASCII.
+  struct JsonValue {
+    enum class Type { null, boolean, number, string, array, object };
+
+    Type type;
+    bool boolean;
+    double number;
+    std::string string;
+    std::vector<JsonValue> array;
+    std::map<std::string, JsonValue> object;
+
+    JsonValue()
+      : type{Type::null}
+      , boolean{false}
+      , number{0}
+      , string{}
+      , array{}
+      , object{}
+    {
+
+    }
+
+    bool has(const std::string & key) const {
+      return type == Type::object && object.count(key) != 0;
+    }
+
+    const JsonValue & at(const std::string & key) const;
+  };
+
+  class JsonError : public std::runtime_error {
+  public:
+    explicit JsonError(const std::string & message)
+      : std::runtime_error{message}
+    {
+
+    }
+  };
+
+  JsonValue parseJson(const std::string & text);
+
+  // Writes s as a quoted JSON string.
+  void writeJsonString(std::ostream & out, const std::string & s);
+}
\ No newline at end of file
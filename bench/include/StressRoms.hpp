@@ -0,0 +1,23 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace bench {
+
+  struct StressRom {
+    std::string name;
+    std::string description;
+    std::vector<char> data;
+  };
+
+  // Synthetic roms that run forever without input, each hammering a different
+  // part of the core. They're generated rather than checked in so that the
+  // program listing sits next to the bytes.
+  std::vector<char> makeAluRom();
+  std::vector<char> makeCallRom();
+  std::vector<char> makeDrawRom();
+  std::vector<char> makeMemoryRom();
+  std::vector<char> makeSelfModifyingRom();
+
+  const std::vector<StressRom> & getStressRoms();
+}
\ No newline at end of file
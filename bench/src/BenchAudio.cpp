@@ -0,0 +1,86 @@
+#include "Benchmark.hpp"
+#include "host/GatedTone.hpp"
+#include "host/PatternWave.hpp"
+#include "host/SquareWave.hpp"
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+  // The audio callback as it was before SquareWave: a std::sin per byte and
+  // the phase in a function-local static. Kept as the reference point.
+  void generateToneWithSine(std::uint8_t * stream, int length) {
+    static double angle = 0.0;
+
+    for(int i = 0; i < length; i++) {
+      int8_t sample = std::sin(angle) >= 0 ? 1 : -1;
+      *stream++ = 5 * sample;
+      angle += 2 * 3.14159265358979323846 / 800;
+    }
+  }
+
+  // Times one audio callback's worth of stereo samples. Items are frames,
+  // so items/s is how far ahead of real time the generator runs.
+  void addCallbackBenchmarks(Registry & registry, std::size_t frames) {
+    const auto suffix = "(" + std::to_string(frames) + " frames, stereo)";
+
+    registry.add("audio:sine callback" + suffix, [frames](State & state) {
+      std::vector<std::uint8_t> buffer(frames * 2);
+      state.setItemsPerIteration(frames);
+
+      while(state.keepRunning()) {
+        generateToneWithSine(buffer.data(), static_cast<int>(buffer.size()));
+        doNotOptimize(buffer);
+      }
+    });
+
+    registry.add("audio:SquareWave::generate" + suffix, [frames](State & state) {
+      std::vector<std::int8_t> buffer(frames * 2);
+      host::SquareWave wave{48000, 120.0, 5};
+      state.setItemsPerIteration(frames);
+
+      while(state.keepRunning()) {
+        wave.generate(buffer.data(), frames, 2);
+        doNotOptimize(buffer);
+      }
+    });
+
+    registry.add("audio:PatternWave::generate" + suffix, [frames](State & state) {
+      std::vector<std::int8_t> buffer(frames * 2);
+      host::PatternWave wave{48000, 5};
+      chip8::ByteArray<chip8::AUDIO_PATTERN_SIZE> pattern{};
+      pattern.fill(0x5A);
+      wave.setPattern(pattern);
+      wave.setPitch(100);
+      state.setItemsPerIteration(frames);
+
+      while(state.keepRunning()) {
+        wave.generate(buffer.data(), frames, 2);
+        doNotOptimize(buffer);
+      }
+    });
+
+    // The callback as it is now: the same wave, gated by an on and an off
+    // event landing inside every buffer.
+    registry.add("audio:GatedTone::render" + suffix, [frames](State & state) {
+      std::vector<std::int8_t> buffer(frames * 2);
+      host::GatedTone tone{48000, 120.0, 5, 2 * frames};
+      state.setItemsPerIteration(frames);
+
+      while(state.keepRunning()) {
+        const auto start = tone.getFramesRendered();
+        tone.push(host::SoundEvent{start + frames / 4, true});
+        tone.push(host::SoundEvent{start + frames / 2, false});
+        tone.render(buffer.data(), frames, 2);
+        doNotOptimize(buffer);
+      }
+    });
+  }
+
+  void registerAudioBenchmarks(Registry & registry) {
+    addCallbackBenchmarks(registry, 4096);
+    addCallbackBenchmarks(registry, 512);
+  }
+}
\ No newline at end of file
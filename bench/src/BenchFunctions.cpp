@@ -0,0 +1,257 @@
+#include "Benchmark.hpp"
+#include "chip8/Assembler.hpp"
+#include "chip8/Disassembler.hpp"
+#include "chip8/Functions.hpp"
+#include "chip8/Opcodes.hpp"
+#include "chip8/Scrolling.hpp"
+#include "chip8/VirtualMachine.hpp"
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+  // A tight loop of register arithmetic that never leaves 0x200..0x20B:
+  //
+  //   0x200: 6101  V1 = 0x01
+  //   0x202: 7201  V2 += 0x01
+  //   0x204: 8214  V2 += V1, VF = carry
+  //   0x206: 8316  V3 >>= 1, VF = lsb
+  //   0x208: 4200  skip if V2 != 0
+  //   0x20A: 1202  jump to 0x202
+  //   0x20C: 1200  jump to 0x200
+  const std::vector<char> DISPATCH_LOOP { {
+    0x61, 0x01,
+    0x72, 0x01,
+    static_cast<char>(0x82), 0x14,
+    static_cast<char>(0x83), 0x16,
+    0x42, 0x00,
+    0x12, 0x02,
+    0x12, 0x00
+  } };
+
+  void prepareDispatchLoop(chip8::VirtualMachine & vm) {
+    chip8::loadFontData(vm, chip8::FONT_DATA);
+    chip8::loadRomData(vm, DISPATCH_LOOP);
+    chip8::reset(vm);
+  }
+
+  void addBlitBenchmark(Registry & registry, chip8::Byte height, chip8::Byte x, chip8::Byte y) {
+    const auto name = "ops::blit(n=" + std::to_string(height)
+      + ", x=" + std::to_string(x)
+      + ", y=" + std::to_string(y) + ")";
+
+    registry.add(name, [height, x, y](State & state) {
+      chip8::VirtualMachine vm;
+
+      for(std::size_t i = 0; i < 16; i++) {
+        vm.memory[0x300 + i] = static_cast<chip8::Byte>(0xA5 ^ (i * 0x11));
+      }
+
+      vm.I = 0x300;
+      vm.registers[0x1] = x;
+      vm.registers[0x2] = y;
+
+      const chip8::Instruction instruction = 0xD120 | height;
+
+      while(state.keepRunning()) {
+        chip8::ops::blit(vm, instruction);
+        doNotOptimize(vm);
+      }
+    });
+  }
+
+  // Scrolls one plane sideways by 4 pixels, as 00FB/00FC do. The cost
+  // doesn't depend on the pixels, so the plane is left to empty out.
+  template <typename Buffer>
+  void addScrollBenchmark(Registry & registry, const std::string & name, void (*scroll)(Buffer &, unsigned int)) {
+    registry.add(name, [scroll](State & state) {
+      Buffer plane;
+      plane.fill(typename Buffer::value_type{});
+
+      while(state.keepRunning()) {
+        scroll(plane, 4);
+        doNotOptimize(plane);
+      }
+    });
+  }
+
+  void registerFunctionBenchmarks(Registry & registry) {
+    registry.add("fetch", [](State & state) {
+      chip8::VirtualMachine vm;
+      prepareDispatchLoop(vm);
+
+      while(state.keepRunning()) {
+        const auto instruction = chip8::fetch(vm);
+        doNotOptimize(instruction);
+        vm.programCounter &= 0x20F;
+      }
+    });
+
+    registry.add("execute(8124)", [](State & state) {
+      chip8::VirtualMachine vm;
+      prepareDispatchLoop(vm);
+
+      while(state.keepRunning()) {
+        chip8::execute(vm, 0x8124);
+        doNotOptimize(vm);
+      }
+    });
+
+    registry.add("execute(F133)", [](State & state) {
+      chip8::VirtualMachine vm;
+      prepareDispatchLoop(vm);
+      vm.I = 0x300;
+
+      while(state.keepRunning()) {
+        chip8::execute(vm, 0xF133);
+        doNotOptimize(vm);
+      }
+    });
+
+    registry.add("cycle(dispatch loop)", [](State & state) {
+      chip8::VirtualMachine vm;
+      prepareDispatchLoop(vm);
+      state.setItemsPerIteration(1);
+
+      while(state.keepRunning()) {
+        chip8::cycle(vm);
+      }
+
+      doNotOptimize(vm);
+    });
+
+    // Many VMs stepped round-robin, as a batch runner would: one cycle of
+    // each per iteration, so every cycle starts on a VM that's gone cold.
+    registry.add("batch:cycle(1024 VMs, dispatch loop)", [](State & state) {
+      const std::size_t count = 1024;
+
+      // std::allocator doesn't honour over-aligned types before C++17.
+      std::vector<char> storage(count * sizeof(chip8::VirtualMachine) + chip8::CACHE_LINE_SIZE);
+      void * start = storage.data();
+      std::size_t space = storage.size();
+      auto vms = static_cast<chip8::VirtualMachine *>(
+        std::align(alignof(chip8::VirtualMachine), count * sizeof(chip8::VirtualMachine), start, space)
+      );
+
+      for(std::size_t i = 0; i < count; i++) {
+        new (&vms[i]) chip8::VirtualMachine{};
+        prepareDispatchLoop(vms[i]);
+      }
+
+      state.setItemsPerIteration(count);
+
+      while(state.keepRunning()) {
+        for(std::size_t i = 0; i < count; i++) {
+          chip8::cycle(vms[i]);
+        }
+      }
+
+      for(std::size_t i = 0; i < count; i++) {
+        doNotOptimize(vms[i]);
+        vms[i].~VirtualMachine();
+      }
+    });
+
+    for(const chip8::Byte height : { 1, 5, 8, 15 }) {
+      addBlitBenchmark(registry, height, 0, 0);
+    }
+
+    // Unaligned, wrapping horizontally, and wrapping vertically.
+    addBlitBenchmark(registry, 8, 3, 10);
+    addBlitBenchmark(registry, 8, 60, 10);
+    addBlitBenchmark(registry, 8, 10, 28);
+
+    // The vectorised scrolls next to the scalar reference they replace.
+    addScrollBenchmark<chip8::GraphicsBuffer>(registry, "scrollPlaneRight(lo-res)", chip8::scrollPlaneRight);
+    addScrollBenchmark<chip8::GraphicsBuffer>(registry, "scrollPlaneRight(lo-res, scalar)", chip8::scalar::scrollPlaneRight);
+    addScrollBenchmark<chip8::HiResGraphicsBuffer>(registry, "scrollPlaneRight(hi-res)", chip8::scrollPlaneRight);
+    addScrollBenchmark<chip8::HiResGraphicsBuffer>(registry, "scrollPlaneRight(hi-res, scalar)", chip8::scalar::scrollPlaneRight);
+    addScrollBenchmark<chip8::HiResGraphicsBuffer>(registry, "scrollPlaneLeft(hi-res)", chip8::scrollPlaneLeft);
+    addScrollBenchmark<chip8::HiResGraphicsBuffer>(registry, "scrollPlaneLeft(hi-res, scalar)", chip8::scalar::scrollPlaneLeft);
+
+    registry.add("loadRomData(3584 bytes)", [](State & state) {
+      chip8::VirtualMachine vm;
+      const std::vector<char> rom(chip8::RAM_SIZE - chip8::PROGRAM_START_ADDRESS, 0x12);
+      state.setItemsPerIteration(rom.size());
+
+      while(state.keepRunning()) {
+        chip8::loadRomData(vm, rom);
+        doNotOptimize(vm);
+      }
+    });
+
+    registry.add("loadFontData", [](State & state) {
+      chip8::VirtualMachine vm;
+
+      while(state.keepRunning()) {
+        chip8::loadFontData(vm, chip8::FONT_DATA);
+        doNotOptimize(vm);
+      }
+    });
+
+    // Every instruction in turn, so each family's template is walked.
+    registry.add("disassemble(Instruction)", [](State & state) {
+      chip8::Instruction instruction = 0;
+      char text[chip8::DISASSEMBLY_MAX_LENGTH];
+      state.setItemsPerIteration(1);
+
+      while(state.keepRunning()) {
+        const auto length = chip8::disassemble(instruction++, 0, text);
+        doNotOptimize(length);
+        doNotOptimize(text);
+      }
+    });
+
+    // A full-sized rom of varied instructions, listed into a reused string.
+    registry.add("disassemble(3584 byte rom)", [](State & state) {
+      std::vector<chip8::Byte> rom(chip8::RAM_SIZE - chip8::PROGRAM_START_ADDRESS);
+
+      for(std::size_t i = 0; i < rom.size(); i++) {
+        rom[i] = static_cast<chip8::Byte>(i * 0x9D + (i >> 3));
+      }
+
+      std::string listing;
+      state.setItemsPerIteration(rom.size() / 2);
+
+      while(state.keepRunning()) {
+        listing.clear();
+        chip8::disassemble(rom.data(), rom.size(), chip8::PROGRAM_START_ADDRESS, listing);
+        doNotOptimize(listing);
+      }
+    });
+
+    // The listing's instructions as source, labels and all, the size of a
+    // rom a test might generate.
+    registry.add("assemble(1792 lines)", [](State & state) {
+      std::string source;
+
+      for(std::size_t i = 0; i < 1792; i++) {
+        const auto instruction = static_cast<chip8::Instruction>(i * 0x9D3B + (i >> 4));
+        source += "l" + std::to_string(i) + ": ";
+        source += chip8::disassemble(instruction).c_str();
+        source += i % 4 == 0 ? " ; a comment\n" : "\n";
+
+        if(i % 16 == 0) {
+          source += "JP l" + std::to_string((i * 7) % 1792) + "\n";
+        }
+      }
+
+      state.setItemsPerIteration(1792);
+
+      while(state.keepRunning()) {
+        const auto rom = chip8::assemble(source, 0);
+        doNotOptimize(rom);
+      }
+    });
+
+    // Construction copies INITIAL_MEMORY, fonts included.
+    registry.add("VirtualMachine()", [](State & state) {
+      while(state.keepRunning()) {
+        chip8::VirtualMachine vm;
+        doNotOptimize(vm);
+      }
+    });
+  }
+}
\ No newline at end of file
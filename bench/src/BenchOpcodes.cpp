@@ -0,0 +1,173 @@
+#include "Benchmark.hpp"
+#include "chip8/Functions.hpp"
+#include "chip8/Opcodes.hpp"
+#include "chip8/VirtualMachine.hpp"
+
+namespace bench {
+
+  using Handler = void (*)(chip8::VirtualMachine &, chip8::Instruction);
+
+  struct OpcodeCase {
+    const char * name;
+    Handler handler;
+    chip8::Instruction instruction;
+  };
+
+  // Every handler that can run repeatedly without external help. The operands
+  // are chosen so that the handler stays in a steady state (e.g. jumps land on
+  // themselves, I stays inside memory).
+  const OpcodeCase OPCODE_CASES[] = {
+    { "ops::jump",                        chip8::ops::jump,                        0x1200 },
+    { "ops::clearScreen",                 chip8::ops::clearScreen,                 0x00E0 },
+    { "ops::scrollDown",                  chip8::ops::scrollDown,                  0x00C4 },
+    { "ops::scrollUp",                    chip8::ops::scrollUp,                    0x00D4 },
+    { "ops::scrollRight",                 chip8::ops::scrollRight,                 0x00FB },
+    { "ops::scrollLeft",                  chip8::ops::scrollLeft,                  0x00FC },
+    { "ops::disableHighResolution",       chip8::ops::disableHighResolution,       0x00FE },
+    { "ops::enableHighResolution",        chip8::ops::enableHighResolution,        0x00FF },
+    { "ops::skipIfEquals",                chip8::ops::skipIfEquals,                0x3142 },
+    { "ops::skipIfNotEquals",             chip8::ops::skipIfNotEquals,             0x4142 },
+    { "ops::skipIfVxEqualsVy",            chip8::ops::skipIfVxEqualsVy,            0x5120 },
+    { "ops::disambiguate0x5",             chip8::ops::disambiguate0x5,             0x5120 },
+    { "ops::storeVxToVy",                 chip8::ops::storeVxToVy,                 0x50F2 },
+    { "ops::loadVxToVy",                  chip8::ops::loadVxToVy,                  0x50F3 },
+    { "ops::setVx",                       chip8::ops::setVx,                       0x6142 },
+    { "ops::addToVx",                     chip8::ops::addToVx,                     0x7101 },
+    { "ops::setVxToVy",                   chip8::ops::setVxToVy,                   0x8120 },
+    { "ops::orVxVy",                      chip8::ops::orVxVy,                      0x8121 },
+    { "ops::andVxVy",                     chip8::ops::andVxVy,                     0x8122 },
+    { "ops::xorVxVy",                     chip8::ops::xorVxVy,                     0x8123 },
+    { "ops::addVxVyUpdateCarry",          chip8::ops::addVxVyUpdateCarry,          0x8124 },
+    { "ops::subtractVxVyUpdateCarry",     chip8::ops::subtractVxVyUpdateCarry,     0x8125 },
+    { "ops::rightshiftVx",                chip8::ops::rightshiftVx,                0x8126 },
+    { "ops::subtractVxFromVyUpdateCarry", chip8::ops::subtractVxFromVyUpdateCarry, 0x8127 },
+    { "ops::leftshiftVx",                 chip8::ops::leftshiftVx,                 0x812E },
+    { "ops::disambiguate0x8",             chip8::ops::disambiguate0x8,             0x8124 },
+    { "ops::skipIfVxNotEqualsVy",         chip8::ops::skipIfVxNotEqualsVy,         0x9120 },
+    { "ops::setIToAddress",               chip8::ops::setIToAddress,               0xA300 },
+    { "ops::jumpPlusV0",                  chip8::ops::jumpPlusV0,                  0xB200 },
+    { "ops::randomVxModNn",               chip8::ops::randomVxModNn,               0xC1FF },
+    { "ops::blit",                        chip8::ops::blit,                        0xD125 },
+    { "ops::skipIfKeyIsPressed",          chip8::ops::skipIfKeyIsPressed,          0xE19E },
+    { "ops::skipIfKeyIsNotPressed",       chip8::ops::skipIfKeyIsNotPressed,       0xE1A1 },
+    { "ops::disambiguate0xE",             chip8::ops::disambiguate0xE,             0xE19E },
+    { "ops::setIToLongAddress",           chip8::ops::setIToLongAddress,           0xF000 },
+    { "ops::selectPlanes",                chip8::ops::selectPlanes,                0xF101 },
+    { "ops::loadAudioPattern",            chip8::ops::loadAudioPattern,            0xF002 },
+    { "ops::setVxToDelayTimer",           chip8::ops::setVxToDelayTimer,           0xF107 },
+    { "ops::waitForKeyPress",             chip8::ops::waitForKeyPress,             0xF10A },
+    { "ops::setDelayTimer",               chip8::ops::setDelayTimer,               0xF115 },
+    { "ops::setSoundTimer",               chip8::ops::setSoundTimer,               0xF118 },
+    { "ops::setPitch",                    chip8::ops::setPitch,                    0xF13A },
+    { "ops::addVxToI",                    chip8::ops::addVxToI,                    0xF01E },
+    { "ops::setIToCharacter",             chip8::ops::setIToCharacter,             0xF129 },
+    { "ops::setIToBigCharacter",          chip8::ops::setIToBigCharacter,          0xF130 },
+    { "ops::storeBcdOfVx",                chip8::ops::storeBcdOfVx,                0xF133 },
+    { "ops::storeV0ToVx",                 chip8::ops::storeV0ToVx,                 0xFF55 },
+    { "ops::loadV0ToVx",                  chip8::ops::loadV0ToVx,                  0xFF65 },
+    { "ops::disambiguate0xF",             chip8::ops::disambiguate0xF,             0xF133 }
+  };
+
+  // The same handlers again with the VM in SUPER-CHIP high resolution, where
+  // they work on the 128x64 buffer instead.
+  const OpcodeCase HIGH_RESOLUTION_OPCODE_CASES[] = {
+    { "ops::clearScreen(hi-res)",         chip8::ops::clearScreen,                 0x00E0 },
+    { "ops::scrollDown(hi-res)",          chip8::ops::scrollDown,                  0x00C4 },
+    { "ops::scrollUp(hi-res)",            chip8::ops::scrollUp,                    0x00D4 },
+    { "ops::scrollRight(hi-res)",         chip8::ops::scrollRight,                 0x00FB },
+    { "ops::scrollLeft(hi-res)",          chip8::ops::scrollLeft,                  0x00FC },
+    { "ops::blit(hi-res)",                chip8::ops::blit,                        0xD125 },
+    { "ops::blit(hi-res 16x16)",          chip8::ops::blit,                        0xD120 }
+  };
+
+  // Drawing and scrolling with both XO-CHIP planes selected, for comparison
+  // with the single plane cases above.
+  const OpcodeCase TWO_PLANE_OPCODE_CASES[] = {
+    { "ops::clearScreen(2 planes)",       chip8::ops::clearScreen,                 0x00E0 },
+    { "ops::scrollRight(2 planes)",       chip8::ops::scrollRight,                 0x00FB },
+    { "ops::blit(2 planes)",              chip8::ops::blit,                        0xD125 }
+  };
+
+  void prepare(chip8::VirtualMachine & vm) {
+    chip8::loadFontData(vm, chip8::FONT_DATA);
+    chip8::reset(vm);
+
+    vm.I = 0x300;
+    vm.registers[0x1] = 0x0A;
+    vm.registers[0x2] = 0x05;
+  }
+
+  void registerOpcodeBenchmarks(Registry & registry) {
+    for(const auto & opcodeCase : OPCODE_CASES) {
+      registry.add(opcodeCase.name, [opcodeCase](State & state) {
+        chip8::VirtualMachine vm;
+        prepare(vm);
+
+        const auto handler = opcodeCase.handler;
+        const auto instruction = opcodeCase.instruction;
+
+        while(state.keepRunning()) {
+          handler(vm, instruction);
+          doNotOptimize(vm);
+        }
+      });
+    }
+
+    for(const auto & opcodeCase : TWO_PLANE_OPCODE_CASES) {
+      registry.add(opcodeCase.name, [opcodeCase](State & state) {
+        chip8::VirtualMachine vm;
+        prepare(vm);
+        chip8::enableXoChip(vm);
+        chip8::ops::selectPlanes(vm, 0xF301);
+
+        const auto handler = opcodeCase.handler;
+        const auto instruction = opcodeCase.instruction;
+
+        while(state.keepRunning()) {
+          handler(vm, instruction);
+          doNotOptimize(vm);
+        }
+      });
+    }
+
+    for(const auto & opcodeCase : HIGH_RESOLUTION_OPCODE_CASES) {
+      registry.add(opcodeCase.name, [opcodeCase](State & state) {
+        chip8::VirtualMachine vm;
+        prepare(vm);
+        chip8::ops::enableHighResolution(vm, 0x00FF);
+
+        const auto handler = opcodeCase.handler;
+        const auto instruction = opcodeCase.instruction;
+
+        while(state.keepRunning()) {
+          handler(vm, instruction);
+          doNotOptimize(vm);
+        }
+      });
+    }
+
+    // callSubroutine and returnFromSubroutine only make sense as a pair: one
+    // grows the stack without bound, the other throws on an empty stack.
+    registry.add("ops::callSubroutine+returnFromSubroutine", [](State & state) {
+      chip8::VirtualMachine vm;
+      prepare(vm);
+
+      while(state.keepRunning()) {
+        chip8::ops::callSubroutine(vm, 0x2300);
+        chip8::ops::returnFromSubroutine(vm, 0x00EE);
+        doNotOptimize(vm);
+      }
+    });
+
+    registry.add("ops::disambiguate0x0(00EE)+callSubroutine", [](State & state) {
+      chip8::VirtualMachine vm;
+      prepare(vm);
+
+      while(state.keepRunning()) {
+        chip8::ops::callSubroutine(vm, 0x2300);
+        chip8::ops::disambiguate0x0(vm, 0x00EE);
+        doNotOptimize(vm);
+      }
+    });
+  }
+}
\ No newline at end of file
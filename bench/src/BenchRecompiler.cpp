@@ -0,0 +1,84 @@
+#include "Benchmark.hpp"
+#include "chip8/Functions.hpp"
+#include "chip8/Recompiler.hpp"
+#include "chip8/VirtualMachine.hpp"
+#include "host/FileUtilities.hpp"
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Generated from assets/brix.chip8 by chip8-recompile at build time.
+extern const chip8::RecompiledRom RECOMPILED_BRIX;
+
+namespace bench {
+
+  // Cycles between 60Hz timer updates at 500Hz, as in the rom benchmarks.
+  // Each iteration runs one such slice.
+  const std::size_t CYCLES_PER_SLICE = 8;
+
+  using SliceFunction = std::function<void(chip8::VirtualMachine &, std::size_t)>;
+
+  // Runs brix the way the rom benchmarks do, a slice at a time, so the
+  // interpreter and the recompiled blocks are measured on the same work.
+  void addBrixBenchmark(Registry & registry, const std::string & name, std::function<SliceFunction(chip8::VirtualMachine &)> prepare) {
+    registry.add(name, [prepare](State & state) {
+      const auto rom = host::readFileAsChar(std::string{CHIP8_ASSETS_DIR} + "/brix.chip8");
+
+      chip8::VirtualMachine vm;
+      chip8::loadRomData(vm, rom);
+      chip8::reset(vm);
+
+      const auto runSlice = prepare(vm);
+      std::uint64_t slices = 0;
+      chip8::Byte key = 0;
+
+      state.setItemsPerIteration(CYCLES_PER_SLICE);
+
+      while(state.keepRunning()) {
+        if(vm.awaitingKeypress) {
+          chip8::handleKeypress(vm, key);
+          key = (key + 1) & 0xF;
+        }
+
+        try {
+          runSlice(vm, CYCLES_PER_SLICE);
+        } catch(const std::exception &) {
+          chip8::loadRomData(vm, rom);
+          chip8::reset(vm);
+          vm.stack = chip8::Stack{};
+        }
+
+        chip8::updateTimers(vm);
+        slices += 1;
+
+        if(slices % 32 == 0) {
+          vm.keyboard.reset();
+        }
+      }
+
+      doNotOptimize(vm);
+    });
+  }
+
+  void registerRecompilerBenchmarks(Registry & registry) {
+    addBrixBenchmark(registry, "aot:cycle(brix)", [](chip8::VirtualMachine &) {
+      return [](chip8::VirtualMachine & vm, std::size_t cycles) {
+        for(std::size_t i = 0; i < cycles; i++) {
+          chip8::cycle(vm);
+        }
+      };
+    });
+
+    // Reloading the same rom after an exception leaves the code as it was,
+    // so the runner never needs to check it again.
+    addBrixBenchmark(registry, "aot:RecompiledRunner(brix)", [](chip8::VirtualMachine & vm) {
+      const auto runner = std::make_shared<chip8::RecompiledRunner>(RECOMPILED_BRIX, vm);
+
+      return [runner](chip8::VirtualMachine & vm, std::size_t cycles) {
+        runner->run(vm, cycles);
+      };
+    });
+  }
+}
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include "Benchmark.hpp"
+#include "StressRoms.hpp"
+#include "chip8/Functions.hpp"
+#include "chip8/VirtualMachine.hpp"
+#include "host/FileUtilities.hpp"
+#include "host/RomCache.hpp"
+#include "host/RomPack.hpp"
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+  // Emulated instructions per 60Hz timer tick when the CPU runs at 500Hz.
+  const std::uint64_t CYCLES_PER_TIMER_TICK = 8;
+
+  const char * const ROM_NAMES[] = {
+    "breakout.chip8",
+    "brix.chip8",
+    "invaders.chip8",
+    "pong.chip8"
+  };
+
+  void addRomBenchmark(Registry & registry, const std::string & name, std::function<std::vector<char>()> load) {
+    registry.add(name, [load](State & state) {
+      const auto rom = load();
+
+      chip8::VirtualMachine vm;
+      chip8::loadFontData(vm, chip8::FONT_DATA);
+      chip8::loadRomData(vm, rom);
+      chip8::reset(vm);
+
+      std::uint64_t cycles = 0;
+      chip8::Byte key = 0;
+
+      state.setItemsPerIteration(1);
+
+      // The bundled roms sit in Fx0A or poll keys, so feed them a rotating
+      // key every so often to keep them moving through their game loops.
+      while(state.keepRunning()) {
+        if(vm.awaitingKeypress) {
+          chip8::handleKeypress(vm, key);
+          key = (key + 1) & 0xF;
+        }
+
+        try {
+          chip8::cycle(vm);
+        } catch(const std::exception &) {
+          chip8::loadRomData(vm, rom);
+          chip8::reset(vm);
+          vm.stack = chip8::Stack{};
+        }
+
+        cycles += 1;
+
+        if(cycles % CYCLES_PER_TIMER_TICK == 0) {
+          chip8::updateTimers(vm);
+        }
+
+        if(cycles % 256 == 0) {
+          vm.keyboard.reset();
+        }
+      }
+
+      doNotOptimize(vm);
+    });
+  }
+
+  void registerRomBenchmarks(Registry & registry) {
+    for(const auto romName : ROM_NAMES) {
+      const std::string path = std::string{CHIP8_ASSETS_DIR} + "/" + romName;
+
+      addRomBenchmark(registry, std::string{"rom:"} + romName, [path]() {
+        return host::readFileAsChar(path);
+      });
+    }
+
+    // Loading itself: the old path through a std::vector next to mapping
+    // the file straight into memory.
+    const std::string brix = std::string{CHIP8_ASSETS_DIR} + "/brix.chip8";
+
+    registry.add("load:readFileAsChar+loadRomData(brix)", [brix](State & state) {
+      chip8::VirtualMachine vm;
+
+      while(state.keepRunning()) {
+        chip8::loadRomData(vm, host::readFileAsChar(brix));
+        doNotOptimize(vm);
+      }
+    });
+
+    registry.add("load:loadRomFile(brix)", [brix](State & state) {
+      chip8::VirtualMachine vm;
+
+      while(state.keepRunning()) {
+        host::loadRomFile(vm, brix);
+        doNotOptimize(vm);
+      }
+    });
+
+    // Starting a VM the way a batch would: font and rom separately from the
+    // file, against one copy of the cached image.
+    registry.add("init:loadFontData+loadRomFile(brix)", [brix](State & state) {
+      chip8::VirtualMachine vm;
+
+      while(state.keepRunning()) {
+        chip8::loadFontData(vm, chip8::FONT_DATA);
+        host::loadRomFile(vm, brix);
+        doNotOptimize(vm);
+      }
+    });
+
+    registry.add("init:RomCache+loadMemoryImage(brix)", [brix](State & state) {
+      chip8::VirtualMachine vm;
+
+      while(state.keepRunning()) {
+        host::RomImage image;
+        host::RomCache::shared().get(brix, image);
+        chip8::loadMemoryImage(vm, *image);
+        doNotOptimize(vm);
+      }
+    });
+
+    // The same rom out of a pack of every bundled rom: an index lookup into
+    // a mapping that's already open.
+    registry.add("load:RomPack::loadRom(brix)", [](State & state) {
+      std::vector<std::vector<char>> roms;
+      std::vector<host::RomSpan> spans;
+
+      for(const auto romName : ROM_NAMES) {
+        roms.push_back(host::readFileAsChar(std::string{CHIP8_ASSETS_DIR} + "/" + romName));
+        spans.push_back(host::RomSpan{ roms.back().data(), roms.back().size() });
+      }
+
+      const std::string packPath = "chip8-bench.c8pk";
+
+      {
+        std::ofstream output{packPath, std::ios::binary};
+        host::writeRomPack(output, spans);
+      }
+
+      const host::RomPack pack{packPath};
+      chip8::VirtualMachine vm;
+
+      while(state.keepRunning()) {
+        pack.loadRom(vm, 1);
+        doNotOptimize(vm);
+      }
+
+      std::remove(packPath.c_str());
+    });
+
+    for(const auto & stressRom : getStressRoms()) {
+      const auto data = stressRom.data;
+
+      addRomBenchmark(registry, "stress:" + stressRom.name, [data]() {
+        return data;
+      });
+    }
+  }
+}
\ No newline at end of file
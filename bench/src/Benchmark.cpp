@@ -0,0 +1,247 @@
+#include "Benchmark.hpp"
+#include "Json.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <sstream>
+
+namespace bench {
+
+  void Registry::add(const std::string & name, BenchmarkFunction function) {
+    benchmarks.push_back(Benchmark{name, function});
+  }
+
+  // Runs the benchmark once with the given iteration count, returning the
+  // measured nanoseconds per iteration.
+  double measure(const Benchmark & benchmark, std::uint64_t iterations, double & itemsPerIteration) {
+    State state{iterations};
+
+    benchmark.function(state);
+    itemsPerIteration = state.getItemsPerIteration();
+
+    return state.getElapsedNanoseconds() / static_cast<double>(iterations);
+  }
+
+  // Grows the iteration count until a single repetition takes at least the
+  // requested minimum time, so that clock resolution doesn't dominate.
+  std::uint64_t calibrate(const Benchmark & benchmark, double minimumSeconds) {
+    const double target = minimumSeconds * 1e9;
+    std::uint64_t iterations = 1;
+    double itemsPerIteration = 0;
+
+    for(;;) {
+      const double nanoseconds = measure(benchmark, iterations, itemsPerIteration) * iterations;
+
+      if(nanoseconds >= target || iterations >= (std::uint64_t{1} << 40)) {
+        return iterations;
+      }
+
+      if(nanoseconds < target / 10) {
+        iterations *= 10;
+      } else {
+        const double scale = (target * 1.2) / std::max(nanoseconds, 1.0);
+        return std::max<std::uint64_t>(iterations + 1, static_cast<std::uint64_t>(iterations * scale));
+      }
+    }
+  }
+
+  Result run(const Benchmark & benchmark, const Options & options) {
+    const auto iterations = calibrate(benchmark, options.minimumSeconds);
+    const auto repetitions = std::max<std::size_t>(options.repetitions, 1);
+    std::vector<double> samples;
+    double itemsPerIteration = 0;
+
+    for(std::size_t i = 0; i < repetitions; i++) {
+      samples.push_back(measure(benchmark, iterations, itemsPerIteration));
+    }
+
+    std::sort(std::begin(samples), std::end(samples));
+
+    const auto count = static_cast<double>(samples.size());
+    const auto mean = std::accumulate(std::begin(samples), std::end(samples), 0.0) / count;
+    const auto middle = samples.size() / 2;
+    const auto median = (samples.size() % 2 == 0)
+      ? (samples[middle - 1] + samples[middle]) / 2
+      : samples[middle];
+
+    double variance = 0;
+
+    for(const auto sample : samples) {
+      variance += (sample - mean) * (sample - mean);
+    }
+
+    Result result;
+    result.name = benchmark.name;
+    result.iterations = iterations;
+    result.repetitions = repetitions;
+    result.medianNanoseconds = median;
+    result.meanNanoseconds = mean;
+    result.stddevNanoseconds = samples.size() > 1 ? std::sqrt(variance / (count - 1)) : 0.0;
+    result.minNanoseconds = samples.front();
+    result.itemsPerSecond = median > 0 ? itemsPerIteration * 1e9 / median : 0.0;
+
+    return result;
+  }
+
+  bool matchesFilters(const std::string & name, const std::vector<std::string> & filters) {
+    if(filters.empty()) {
+      return true;
+    }
+
+    return std::any_of(std::begin(filters), std::end(filters), [&name](const std::string & filter) {
+      return name.find(filter) != std::string::npos;
+    });
+  }
+
+  std::vector<Result> runAll(const Registry & registry, const Options & options, std::ostream & out) {
+    std::vector<Result> results;
+
+    printHeader(out);
+
+    for(const auto & benchmark : registry.getBenchmarks()) {
+      if(!matchesFilters(benchmark.name, options.filters)) {
+        continue;
+      }
+
+      results.push_back(run(benchmark, options));
+      printResult(results.back(), out);
+    }
+
+    return results;
+  }
+
+  void printHeader(std::ostream & out) {
+    out << std::left << std::setw(44) << "benchmark"
+        << std::right << std::setw(14) << "iterations"
+        << std::setw(14) << "median ns/op"
+        << std::setw(12) << "mean"
+        << std::setw(10) << "cv"
+        << std::setw(16) << "items/s" << "\n"
+        << std::string(110, '-') << std::endl;
+  }
+
+  void printResult(const Result & result, std::ostream & out) {
+    const auto flags = out.flags();
+    const auto cv = result.meanNanoseconds > 0 ? 100.0 * result.stddevNanoseconds / result.meanNanoseconds : 0.0;
+
+    out << std::left << std::setw(44) << result.name
+        << std::right << std::setw(14) << result.iterations
+        << std::fixed << std::setprecision(2)
+        << std::setw(14) << result.medianNanoseconds
+        << std::setw(12) << result.meanNanoseconds
+        << std::setw(9) << cv << "%";
+
+    if(result.itemsPerSecond > 0) {
+      out << std::setw(16) << std::scientific << std::setprecision(3) << result.itemsPerSecond;
+    }
+
+    out << std::endl;
+    out.flags(flags);
+  }
+
+  void writeResults(const std::vector<Result> & results, const std::string & build, std::ostream & out) {
+    out << std::setprecision(6) << "{\n  \"build\": ";
+    writeJsonString(out, build);
+    out << ",\n  \"benchmarks\": [";
+
+    for(std::size_t i = 0; i < results.size(); i++) {
+      const auto & result = results[i];
+
+      out << (i == 0 ? "\n" : ",\n") << "    { \"name\": ";
+      writeJsonString(out, result.name);
+      out << ", \"median_ns\": " << result.medianNanoseconds
+          << ", \"mean_ns\": " << result.meanNanoseconds
+          << ", \"stddev_ns\": " << result.stddevNanoseconds
+          << ", \"min_ns\": " << result.minNanoseconds
+          << ", \"items_per_second\": " << result.itemsPerSecond
+          << ", \"iterations\": " << result.iterations
+          << ", \"repetitions\": " << result.repetitions << " }";
+    }
+
+    out << "\n  ]\n}\n";
+  }
+
+  void printComparison(const std::vector<Result> & results, const std::string & referencePath, std::ostream & out) {
+    std::ifstream file{referencePath};
+
+    if(!file.is_open()) {
+      throw std::runtime_error("Cannot read " + referencePath);
+    }
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+
+    const auto reference = parseJson(buffer.str());
+    std::map<std::string, double> referenceMedians;
+
+    for(const auto & entry : reference.at("benchmarks").array) {
+      referenceMedians[entry.at("name").string] = entry.at("median_ns").number;
+    }
+
+    const auto flags = out.flags();
+
+    out << "\ncompared with " << referencePath;
+
+    if(reference.has("build")) {
+      out << " (" << reference.at("build").string << ")";
+    }
+
+    out << "\n" << std::left << std::setw(44) << "benchmark"
+        << std::right << std::setw(14) << "reference ns"
+        << std::setw(14) << "this ns"
+        << std::setw(12) << "speedup" << "\n"
+        << std::string(84, '-') << "\n";
+
+    for(const auto & result : results) {
+      const auto found = referenceMedians.find(result.name);
+
+      if(found == referenceMedians.end() || result.medianNanoseconds <= 0) {
+        continue;
+      }
+
+      out << std::left << std::setw(44) << result.name
+          << std::right << std::fixed << std::setprecision(2)
+          << std::setw(14) << found->second
+          << std::setw(14) << result.medianNanoseconds
+          << std::setw(11) << found->second / result.medianNanoseconds << "x\n";
+    }
+
+    out << std::flush;
+    out.flags(flags);
+  }
+
+  bool parseOptions(const std::vector<std::string> & args, Options & options, std::ostream & err) {
+    for(std::size_t i = 0; i < args.size(); i++) {
+      const auto & arg = args[i];
+      const bool hasValue = i + 1 < args.size();
+
+      if(arg == "--repetitions" && hasValue) {
+        options.repetitions = std::stoul(args[++i]);
+      } else if(arg == "--min-time" && hasValue) {
+        options.minimumSeconds = std::stod(args[++i]);
+      } else if(arg == "--filter" && hasValue) {
+        std::stringstream filters{args[++i]};
+        std::string filter;
+
+        while(std::getline(filters, filter, ',')) {
+          options.filters.push_back(filter);
+        }
+      } else if(arg == "--output" && hasValue) {
+        options.outputPath = args[++i];
+      } else if(arg == "--compare" && hasValue) {
+        options.comparePath = args[++i];
+      } else {
+        err << "Unknown or incomplete option: " << arg << "\n"
+            << "Options: --repetitions N  --min-time SECONDS  --filter SUBSTRING[,SUBSTRING...]\n"
+            << "         --output RESULTS.json  --compare RESULTS.json" << std::endl;
+        return false;
+      }
+    }
+
+    return true;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,313 @@
+#include "StressRoms.hpp"
+#include "chip8/Functions.hpp"
+#include "chip8/VirtualMachine.hpp"
+#include "host/EmulationClock.hpp"
+#include "host/RomCache.hpp"
+#include "host/RomPack.hpp"
+#include "host/WavAudioSink.hpp"
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+  // The emulated rates the host's EmulationClock runs at: a 500Hz CPU and
+  // 60Hz timers.
+  const std::uint64_t CYCLES_PER_SECOND = host::CLOCK_TICKS_PER_SECOND / host::CLOCK_TICKS_PER_CYCLE;
+
+  struct Workload {
+    std::string name;
+    host::RomImage image;
+  };
+
+  struct RunResult {
+    chip8::LoadStatus status;
+    std::uint64_t cycles;
+    double seconds;
+    std::uint64_t digest;
+  };
+
+  // FNV-1a over everything a rom can observe, so two runs of the same
+  // workload can be compared for identical behaviour, not just speed.
+  std::uint64_t digestOf(const chip8::VirtualMachine & vm) {
+    std::uint64_t hash = 14695981039346656037ULL;
+
+    const auto mix = [&hash](std::uint64_t value, std::size_t bytes) {
+      for(std::size_t i = 0; i < bytes; i++) {
+        hash ^= (value >> (i * 8)) & 0xFF;
+        hash *= 1099511628211ULL;
+      }
+    };
+
+    for(const auto byte : vm.memory) {
+      mix(byte, 1);
+    }
+
+    for(const auto byte : vm.registers) {
+      mix(byte, 1);
+    }
+
+    for(const auto row : vm.graphics) {
+      mix(row, sizeof(row));
+    }
+
+    // Only mixed in once a rom switches to it, so low resolution digests are
+    // unaffected by the SUPER-CHIP buffer.
+    if(vm.highResolution) {
+      for(const auto & row : vm.hiResGraphics) {
+        mix(row[0], sizeof(row[0]));
+        mix(row[1], sizeof(row[1]));
+      }
+    }
+
+    if(vm.xoChip) {
+      for(const auto row : vm.graphicsPlane2) {
+        mix(row, sizeof(row));
+      }
+
+      if(vm.highResolution) {
+        for(const auto & row : vm.hiResGraphicsPlane2) {
+          mix(row[0], sizeof(row[0]));
+          mix(row[1], sizeof(row[1]));
+        }
+      }
+    }
+
+    mix(vm.programCounter, sizeof(vm.programCounter));
+    mix(vm.I, sizeof(vm.I));
+
+    return hash;
+  }
+
+  // With audio, the buzzer is rendered against emulated time, as if the rom
+  // ran at CYCLES_PER_SECOND.
+  RunResult runHeadless(const Workload & workload, std::uint64_t cycles, bool xoChip, host::AudioSink * audio) {
+    chip8::VirtualMachine vm;
+
+    if(xoChip) {
+      chip8::enableXoChip(vm);
+    }
+
+    // A fixed-seed generator keeps CXNN deterministic between runs.
+    std::uint32_t seed = 0x2545F491;
+    vm.rng = [&seed](chip8::Byte) -> chip8::Byte {
+      seed = seed * 1664525 + 1013904223;
+      return static_cast<chip8::Byte>(seed >> 24);
+    };
+
+    // A rom cached for XO-CHIP's memory may not fit a plain CHIP-8 VM.
+    const auto status = chip8::loadMemoryImage(vm, *workload.image);
+
+    if(status != chip8::LoadStatus::Loaded) {
+      return { status, 0, 0.0, 0 };
+    }
+
+    chip8::reset(vm);
+
+    chip8::Byte key = 0;
+    std::uint64_t nextTimerUpdate = host::CLOCK_TICKS_PER_TIMER_UPDATE;
+    const auto start = std::chrono::steady_clock::now();
+
+    for(std::uint64_t i = 1; i <= cycles; i++) {
+      // Roms that block on Fx0A get a rotating key so they keep moving.
+      if(vm.awaitingKeypress) {
+        chip8::handleKeypress(vm, key);
+        key = (key + 1) & 0xF;
+      }
+
+      try {
+        chip8::cycle(vm);
+      } catch(const std::exception & e) {
+        std::cerr << workload.name << ": " << e.what() << " at cycle " << i << "; restarting rom" << std::endl;
+        // The image loaded once already, into this same VM.
+        chip8::loadMemoryImage(vm, *workload.image);
+        chip8::reset(vm);
+        vm.stack = chip8::Stack{};
+      }
+
+      // Timers update on the same clock ticks as in the host, between every
+      // eighth or ninth cycle.
+      if(i * host::CLOCK_TICKS_PER_CYCLE >= nextTimerUpdate) {
+        chip8::updateTimers(vm);
+        nextTimerUpdate += host::CLOCK_TICKS_PER_TIMER_UPDATE;
+      }
+
+      if(audio) {
+        host::updateAudio(*audio, vm, true, i);
+      }
+
+      if(i % 256 == 0) {
+        vm.keyboard.reset();
+      }
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+
+    return {
+      status,
+      cycles,
+      std::chrono::duration<double>(end - start).count(),
+      digestOf(vm)
+    };
+  }
+
+  bool writeRom(const std::string & path, const std::vector<char> & data) {
+    std::ofstream file{path, std::ios::binary};
+    file.write(data.data(), data.size());
+    return static_cast<bool>(file);
+  }
+
+  void printRuns(const std::vector<Workload> & workloads, std::uint64_t cycles, bool xoChip, host::AudioSink * audio) {
+    std::cout << std::left << std::setw(32) << "workload"
+              << std::right << std::setw(14) << "cycles"
+              << std::setw(12) << "seconds"
+              << std::setw(10) << "MIPS"
+              << std::setw(20) << "state digest" << "\n"
+              << std::string(88, '-') << std::endl;
+
+    for(const auto & workload : workloads) {
+      const auto result = runHeadless(workload, cycles, xoChip, audio);
+
+      if(result.status != chip8::LoadStatus::Loaded) {
+        std::cerr << workload.name << ": " << chip8::describe(result.status) << "; skipped" << std::endl;
+        continue;
+      }
+
+      const auto mips = result.seconds > 0 ? result.cycles / result.seconds / 1e6 : 0.0;
+
+      std::cout << std::left << std::setw(32) << workload.name
+                << std::right << std::setw(14) << result.cycles
+                << std::fixed << std::setprecision(3)
+                << std::setw(12) << result.seconds
+                << std::setw(10) << std::setprecision(2) << mips
+                << "    " << std::hex << std::setfill('0') << std::setw(16) << result.digest
+                << std::dec << std::setfill(' ') << std::endl;
+    }
+  }
+
+  void printUsage() {
+    std::cerr << "Usage: chip8-headless [--cycles N] [--xo-chip] [--wav FILE] [--write DIR]\n"
+              << "                      [--pack FILE] [rom ...]\n"
+              << "Runs each rom without a window for N cycles and reports MIPS.\n"
+              << "With no roms, runs the built-in synthetic stress suite.\n"
+              << "--xo-chip runs the roms with XO-CHIP's 64KB memory.\n"
+              << "--pack FILE also runs every rom in a pack made by chip8-pack.\n"
+              << "--wav FILE renders the buzzer of a single rom to FILE, timed as if the\n"
+              << "rom ran at 500 cycles per second.\n"
+              << "--write DIR saves the stress roms to DIR instead of running them." << std::endl;
+  }
+}
+
+int main(int argc, char** argv) {
+  const std::vector<std::string> args(argv + 1, argv + argc);
+
+  std::uint64_t cycles = 10000000;
+  std::string writeDirectory;
+  std::string wavPath;
+  bool xoChip = false;
+  std::vector<Workload> workloads;
+
+  for(std::size_t i = 0; i < args.size(); i++) {
+    const bool hasValue = i + 1 < args.size();
+
+    if(args[i] == "--cycles" && hasValue) {
+      cycles = std::stoull(args[++i]);
+    } else if(args[i] == "--write" && hasValue) {
+      writeDirectory = args[++i];
+    } else if(args[i] == "--wav" && hasValue) {
+      wavPath = args[++i];
+    } else if(args[i] == "--xo-chip") {
+      xoChip = true;
+    } else if(args[i] == "--pack" && hasValue) {
+      const auto packPath = args[++i];
+
+      try {
+        const host::RomPack pack{packPath};
+
+        for(std::size_t rom = 0; rom < pack.size(); rom++) {
+          const auto span = pack.getRom(rom);
+          const auto name = packPath + "[" + std::to_string(rom) + "]";
+          host::RomImage image;
+          const auto status = host::RomCache::shared().get(span.data, span.size, image);
+
+          if(status != chip8::LoadStatus::Loaded) {
+            std::cerr << name << ": " << chip8::describe(status) << std::endl;
+            return 1;
+          }
+
+          workloads.push_back({ name, image });
+        }
+      } catch(const std::exception & e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+      }
+    } else if(!args[i].empty() && args[i][0] == '-') {
+      printUsage();
+      return 1;
+    } else {
+      host::RomImage image;
+      const auto status = host::RomCache::shared().get(args[i], image);
+
+      if(status != chip8::LoadStatus::Loaded) {
+        std::cerr << args[i] << ": " << chip8::describe(status) << std::endl;
+        return 1;
+      }
+
+      workloads.push_back({ args[i], image });
+    }
+  }
+
+  if(!writeDirectory.empty()) {
+    for(const auto & rom : bench::getStressRoms()) {
+      const auto path = writeDirectory + "/stress-" + rom.name + ".chip8";
+
+      if(!writeRom(path, rom.data)) {
+        std::cerr << "Could not write " << path << std::endl;
+        return 1;
+      }
+
+      std::cout << path << ": " << rom.description << std::endl;
+    }
+
+    return 0;
+  }
+
+  if(workloads.empty()) {
+    for(const auto & rom : bench::getStressRoms()) {
+      host::RomImage image;
+      host::RomCache::shared().get(rom.data.data(), rom.data.size(), image);
+      workloads.push_back({ rom.name, image });
+    }
+  }
+
+  if(wavPath.empty()) {
+    printRuns(workloads, cycles, xoChip, nullptr);
+    return 0;
+  }
+
+  if(workloads.size() != 1) {
+    std::cerr << "--wav needs exactly one rom" << std::endl;
+    return 1;
+  }
+
+  try {
+    host::WavAudioSink audio{wavPath, CYCLES_PER_SECOND};
+
+    printRuns(workloads, cycles, xoChip, &audio);
+
+    if(!audio.finish(cycles)) {
+      std::cerr << "Could not write " << wavPath << std::endl;
+      return 1;
+    }
+  } catch(const std::exception & e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,219 @@
+#include "Json.hpp"
+#include <cctype>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+namespace bench {
+
+  const JsonValue & JsonValue::at(const std::string & key) const {
+    if(!has(key)) {
+      throw JsonError("Missing key \"" + key + "\"");
+    }
+
+    return object.find(key)->second;
+  }
+
+  class JsonParser {
+  private:
+    const std::string & text;
+    std::size_t position;
+
+    [[noreturn]] void fail(const std::string & message) const {
+      throw JsonError(message + " at offset " + std::to_string(position));
+    }
+
+    void skipWhitespace() {
+      while(position < text.size() && std::isspace(static_cast<unsigned char>(text[position]))) {
+        position++;
+      }
+    }
+
+    char peek() {
+      skipWhitespace();
+
+      if(position >= text.size()) {
+        fail("Unexpected end of input");
+      }
+
+      return text[position];
+    }
+
+    void expect(char c) {
+      if(peek() != c) {
+        fail(std::string{"Expected '"} + c + "'");
+      }
+
+      position++;
+    }
+
+    bool consumeLiteral(const char * literal) {
+      const std::string word{literal};
+
+      if(text.compare(position, word.size(), word) == 0) {
+        position += word.size();
+        return true;
+      }
+
+      return false;
+    }
+
+    std::string parseString() {
+      expect('"');
+      std::string result;
+
+      while(position < text.size() && text[position] != '"') {
+        char c = text[position++];
+
+        if(c == '\\') {
+          if(position >= text.size()) {
+            fail("Unterminated escape");
+          }
+
+          c = text[position++];
+
+          switch(c) {
+            case 'n': result += '\n'; break;
+            case 't': result += '\t'; break;
+            case 'r': result += '\r'; break;
+            case 'b': result += '\b'; break;
+            case 'f': result += '\f'; break;
+            case 'u':
+              if(position + 4 > text.size()) {
+                fail("Truncated \\u escape");
+              }
+
+              result += static_cast<char>(std::strtol(text.substr(position, 4).c_str(), nullptr, 16));
+              position += 4;
+              break;
+            default: result += c; break;
+          }
+        } else {
+          result += c;
+        }
+      }
+
+      expect('"');
+      return result;
+    }
+
+    JsonValue parseValue() {
+      JsonValue value;
+      const char c = peek();
+
+      if(c == '{') {
+        position++;
+        value.type = JsonValue::Type::object;
+
+        if(peek() == '}') {
+          position++;
+          return value;
+        }
+
+        for(;;) {
+          const auto key = parseString();
+          expect(':');
+          value.object[key] = parseValue();
+
+          if(peek() == ',') {
+            position++;
+          } else {
+            expect('}');
+            return value;
+          }
+        }
+      } else if(c == '[') {
+        position++;
+        value.type = JsonValue::Type::array;
+
+        if(peek() == ']') {
+          position++;
+          return value;
+        }
+
+        for(;;) {
+          value.array.push_back(parseValue());
+
+          if(peek() == ',') {
+            position++;
+          } else {
+            expect(']');
+            return value;
+          }
+        }
+      } else if(c == '"') {
+        value.type = JsonValue::Type::string;
+        value.string = parseString();
+      } else if(consumeLiteral("true")) {
+        value.type = JsonValue::Type::boolean;
+        value.boolean = true;
+      } else if(consumeLiteral("false")) {
+        value.type = JsonValue::Type::boolean;
+      } else if(consumeLiteral("null")) {
+        value.type = JsonValue::Type::null;
+      } else {
+        const char * begin = text.c_str() + position;
+        char * end = nullptr;
+
+        value.type = JsonValue::Type::number;
+        value.number = std::strtod(begin, &end);
+
+        if(end == begin) {
+          fail("Unexpected character");
+        }
+
+        position += end - begin;
+      }
+
+      return value;
+    }
+
+  public:
+    explicit JsonParser(const std::string & text)
+      : text{text}
+      , position{0}
+    {
+
+    }
+
+    JsonValue parse() {
+      auto value = parseValue();
+      skipWhitespace();
+
+      if(position != text.size()) {
+        fail("Trailing characters");
+      }
+
+      return value;
+    }
+  };
+
+  JsonValue parseJson(const std::string & text) {
+    return JsonParser{text}.parse();
+  }
+
+  void writeJsonString(std::ostream & out, const std::string & s) {
+    out << '"';
+
+    for(const auto c : s) {
+      switch(c) {
+        case '"': out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n"; break;
+        case '\t': out << "\\t"; break;
+        default:
+          if(static_cast<unsigned char>(c) < 0x20) {
+            const auto flags = out.flags();
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c);
+            out.flags(flags);
+            out << std::setfill(' ');
+          } else {
+            out << c;
+          }
+          break;
+      }
+    }
+
+    out << '"';
+  }
+}
\ No newline at end of file
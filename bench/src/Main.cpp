@@ -0,0 +1,43 @@
+#include "Benchmark.hpp"
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv) {
+  const std::vector<std::string> args(argv + 1, argv + argc);
+
+  bench::Options options;
+
+  if(!bench::parseOptions(args, options, std::cerr)) {
+    return 1;
+  }
+
+  bench::Registry registry;
+  bench::registerOpcodeBenchmarks(registry);
+  bench::registerFunctionBenchmarks(registry);
+  bench::registerRomBenchmarks(registry);
+  bench::registerAudioBenchmarks(registry);
+  bench::registerRecompilerBenchmarks(registry);
+
+  std::cout << "build: " << CHIP8_BUILD_DESCRIPTION << "\n" << std::endl;
+
+  const auto results = bench::runAll(registry, options, std::cout);
+
+  if(!options.outputPath.empty()) {
+    std::ofstream output{options.outputPath};
+    bench::writeResults(results, CHIP8_BUILD_DESCRIPTION, output);
+  }
+
+  if(!options.comparePath.empty()) {
+    try {
+      bench::printComparison(results, options.comparePath, std::cout);
+    } catch(const std::exception & e) {
+      std::cerr << e.what() << std::endl;
+      return 1;
+    }
+  }
+
+  return 0;
+}
\ No newline at end of file
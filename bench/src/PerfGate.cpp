@@ -0,0 +1,314 @@
+#include "Benchmark.hpp"
+#include "Json.hpp"
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+  struct GateOptions {
+    std::string baselinePath;
+    std::string outputPath;
+    double tolerance;
+    bool hasToleranceOverride;
+    bool updateBaseline;
+    std::size_t retries;
+    bench::Options benchmark;
+
+    GateOptions()
+      : baselinePath{}
+      , outputPath{}
+      , tolerance{0.25}
+      , hasToleranceOverride{false}
+      , updateBaseline{false}
+      , retries{2}
+      , benchmark{}
+    {
+
+    }
+  };
+
+  struct BaselineEntry {
+    double relativeCost;
+    double tolerance;
+    bool hasTolerance;
+  };
+
+  // A gated measurement: the benchmark's fastest repetition divided by the
+  // fastest repetition of the reference loop measured right before it.
+  // Dividing out the reference cancels most of the machine's speed and its
+  // current frequency/load state, so baselines travel between runs and boxes
+  // far better than raw nanoseconds do.
+  struct GateResult {
+    bench::Result result;
+    double referenceNanoseconds;
+    double relativeCost;
+  };
+
+  struct Baseline {
+    double tolerance;
+    std::vector<std::string> order;
+    std::map<std::string, BaselineEntry> entries;
+  };
+
+  void printUsage() {
+    std::cerr << "Usage: chip8-perfgate --baseline FILE [--output FILE] [--tolerance FRACTION]\n"
+              << "                      [--update-baseline] [--retries N] [--repetitions N]\n"
+              << "                      [--min-time SECONDS]\n"
+              << "Runs the benchmarks named in the baseline, writes the results as JSON and\n"
+              << "exits non-zero if any benchmark's cost relative to a reference loop grew\n"
+              << "by more than the tolerance. A benchmark that looks regressed is measured\n"
+              << "again up to --retries times and its best run is kept, so one noisy\n"
+              << "sample doesn't fail the gate.\n"
+              << "--update-baseline rewrites the baseline with the new measurements." << std::endl;
+  }
+
+  bool parseGateOptions(const std::vector<std::string> & args, GateOptions & options) {
+    std::vector<std::string> benchmarkArgs;
+
+    for(std::size_t i = 0; i < args.size(); i++) {
+      const bool hasValue = i + 1 < args.size();
+
+      if(args[i] == "--baseline" && hasValue) {
+        options.baselinePath = args[++i];
+      } else if(args[i] == "--output" && hasValue) {
+        options.outputPath = args[++i];
+      } else if(args[i] == "--tolerance" && hasValue) {
+        options.tolerance = std::stod(args[++i]);
+        options.hasToleranceOverride = true;
+      } else if(args[i] == "--retries" && hasValue) {
+        options.retries = std::stoul(args[++i]);
+      } else if(args[i] == "--update-baseline") {
+        options.updateBaseline = true;
+      } else if((args[i] == "--repetitions" || args[i] == "--min-time") && hasValue) {
+        benchmarkArgs.push_back(args[i]);
+        benchmarkArgs.push_back(args[++i]);
+      } else {
+        return false;
+      }
+    }
+
+    return !options.baselinePath.empty() && bench::parseOptions(benchmarkArgs, options.benchmark, std::cerr);
+  }
+
+  Baseline readBaseline(const std::string & path) {
+    std::ifstream file{path};
+
+    if(!file.is_open()) {
+      throw std::runtime_error("Cannot read baseline " + path);
+    }
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+
+    const auto json = bench::parseJson(buffer.str());
+
+    Baseline baseline;
+    baseline.tolerance = json.has("tolerance") ? json.at("tolerance").number : 0.25;
+
+    for(const auto & entry : json.at("benchmarks").array) {
+      const auto & name = entry.at("name").string;
+
+      baseline.order.push_back(name);
+      baseline.entries[name] = BaselineEntry{
+        entry.at("relative_cost").number,
+        entry.has("tolerance") ? entry.at("tolerance").number : 0.0,
+        entry.has("tolerance")
+      };
+    }
+
+    return baseline;
+  }
+
+  void writeResults(std::ostream & out, const std::vector<GateResult> & results, const Baseline & baseline) {
+    out << std::setprecision(6);
+    out << "{\n  \"tolerance\": " << baseline.tolerance << ",\n  \"benchmarks\": [";
+
+    for(std::size_t i = 0; i < results.size(); i++) {
+      const auto & result = results[i].result;
+      const auto entry = baseline.entries.find(result.name);
+
+      out << (i == 0 ? "\n" : ",\n") << "    { \"name\": ";
+      bench::writeJsonString(out, result.name);
+      out << ", \"relative_cost\": " << results[i].relativeCost
+          << ", \"reference_ns\": " << results[i].referenceNanoseconds
+          << ", \"median_ns\": " << result.medianNanoseconds
+          << ", \"mean_ns\": " << result.meanNanoseconds
+          << ", \"stddev_ns\": " << result.stddevNanoseconds
+          << ", \"min_ns\": " << result.minNanoseconds
+          << ", \"items_per_second\": " << result.itemsPerSecond
+          << ", \"iterations\": " << result.iterations
+          << ", \"repetitions\": " << result.repetitions;
+
+      if(entry != baseline.entries.end() && entry->second.hasTolerance) {
+        out << ", \"tolerance\": " << entry->second.tolerance;
+      }
+
+      out << " }";
+    }
+
+    out << "\n  ]\n}\n";
+  }
+
+  // A fixed, dependency-chained integer workload that doesn't touch the
+  // emulator, used as the yardstick for every gated benchmark.
+  void referenceLoop(bench::State & state) {
+    std::uint64_t value = 0x9E3779B97F4A7C15ULL;
+
+    while(state.keepRunning()) {
+      value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+      value ^= value >> 29;
+      bench::doNotOptimize(value);
+    }
+  }
+
+  GateResult measure(const bench::Benchmark & benchmark, const bench::Options & options) {
+    const bench::Benchmark reference{"reference", referenceLoop};
+    const auto referenceResult = bench::run(reference, options);
+    const auto result = bench::run(benchmark, options);
+
+    return GateResult{
+      result,
+      referenceResult.minNanoseconds,
+      result.minNanoseconds / referenceResult.minNanoseconds
+    };
+  }
+
+  // Keeps whichever of the two measurements ran cheaper.
+  void keepBest(GateResult & best, const GateResult & candidate) {
+    if(candidate.relativeCost < best.relativeCost) {
+      best = candidate;
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  const std::vector<std::string> args(argv + 1, argv + argc);
+
+  GateOptions options;
+
+  if(!parseGateOptions(args, options)) {
+    printUsage();
+    return 2;
+  }
+
+  Baseline baseline;
+
+  try {
+    baseline = readBaseline(options.baselinePath);
+  } catch(const std::exception & e) {
+    std::cerr << e.what() << std::endl;
+    return 2;
+  }
+
+  if(options.hasToleranceOverride) {
+    baseline.tolerance = options.tolerance;
+  }
+
+  bench::Registry all;
+  bench::registerOpcodeBenchmarks(all);
+  bench::registerFunctionBenchmarks(all);
+  bench::registerRomBenchmarks(all);
+  bench::registerAudioBenchmarks(all);
+
+  // Only the benchmarks named in the baseline form the gate, in its order.
+  std::vector<bench::Benchmark> gated;
+
+  for(const auto & name : baseline.order) {
+    bool found = false;
+
+    for(const auto & benchmark : all.getBenchmarks()) {
+      if(benchmark.name == name) {
+        gated.push_back(benchmark);
+        found = true;
+      }
+    }
+
+    if(!found) {
+      std::cerr << "Baseline names an unknown benchmark: " << name << std::endl;
+      return 2;
+    }
+  }
+
+  std::vector<GateResult> results;
+
+  bench::printHeader(std::cout);
+
+  for(const auto & benchmark : gated) {
+    auto result = measure(benchmark, options.benchmark);
+
+    // A new baseline is the best of every attempt, matching how the gate
+    // treats retried measurements below.
+    if(options.updateBaseline) {
+      for(std::size_t attempt = 0; attempt < options.retries; attempt++) {
+        keepBest(result, measure(benchmark, options.benchmark));
+      }
+    }
+
+    results.push_back(result);
+    bench::printResult(result.result, std::cout);
+  }
+
+  if(options.updateBaseline) {
+    std::ofstream output{options.baselinePath};
+    writeResults(output, results, baseline);
+    std::cout << "\nBaseline updated: " << options.baselinePath << std::endl;
+    return 0;
+  }
+
+  std::size_t regressions = 0;
+
+  std::cout << "\n" << std::left << std::setw(44) << "benchmark"
+            << std::right << std::setw(14) << "baseline"
+            << std::setw(14) << "current"
+            << std::setw(10) << "change"
+            << std::setw(11) << "allowed" << "\n"
+            << std::string(93, '-') << std::endl;
+
+  for(std::size_t i = 0; i < results.size(); i++) {
+    auto & gateResult = results[i];
+    const auto & name = gateResult.result.name;
+    const auto & entry = baseline.entries[name];
+    const auto tolerance = (entry.hasTolerance && !options.hasToleranceOverride) ? entry.tolerance : baseline.tolerance;
+    const auto changeOf = [&entry](const GateResult & result) {
+      return entry.relativeCost > 0 ? result.relativeCost / entry.relativeCost - 1.0 : 0.0;
+    };
+
+    for(std::size_t attempt = 0; attempt < options.retries && changeOf(gateResult) > tolerance; attempt++) {
+      keepBest(gateResult, measure(gated[i], options.benchmark));
+    }
+
+    const auto change = changeOf(gateResult);
+    const bool regressed = change > tolerance;
+
+    if(regressed) {
+      regressions += 1;
+    }
+
+    std::cout << std::left << std::setw(44) << name
+              << std::right << std::fixed << std::setprecision(3)
+              << std::setw(14) << entry.relativeCost
+              << std::setw(14) << gateResult.relativeCost
+              << std::setprecision(2)
+              << std::setw(9) << std::showpos << change * 100 << "%" << std::noshowpos
+              << std::setw(10) << tolerance * 100 << "%"
+              << (regressed ? "  REGRESSION" : "") << std::endl;
+  }
+
+  if(!options.outputPath.empty()) {
+    std::ofstream output{options.outputPath};
+    writeResults(output, results, baseline);
+  }
+
+  if(regressions > 0) {
+    std::cout << "\n" << regressions << " benchmark(s) regressed beyond tolerance." << std::endl;
+    return 1;
+  }
+
+  std::cout << "\nNo regressions." << std::endl;
+  return 0;
+}
\ No newline at end of file
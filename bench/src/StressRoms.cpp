@@ -0,0 +1,123 @@
+#include "StressRoms.hpp"
+#include "chip8/Types.hpp"
+#include <initializer_list>
+
+namespace bench {
+
+  // Lays instructions out big-endian, the way fetch() expects them.
+  std::vector<char> assemble(std::initializer_list<chip8::Instruction> instructions) {
+    std::vector<char> rom;
+
+    for(const auto instruction : instructions) {
+      rom.push_back(static_cast<char>(instruction >> 8));
+      rom.push_back(static_cast<char>(instruction & 0xFF));
+    }
+
+    return rom;
+  }
+
+  std::vector<char> makeAluRom() {
+    return assemble({
+      0x6001, // 0x200: V0 = 0x01
+      0x6103, // 0x202: V1 = 0x03
+      0x7207, // 0x204: V2 += 0x07
+      0x8324, // 0x206: V3 += V2, VF = carry
+      0x8415, // 0x208: V4 -= V1, VF = !borrow
+      0x8531, // 0x20A: V5 |= V3
+      0x8642, // 0x20C: V6 &= V4
+      0x8753, // 0x20E: V7 ^= V5
+      0x8806, // 0x210: V8 >>= 1, VF = lsb
+      0x890E, // 0x212: V9 <<= 1, VF = msb
+      0x8A47, // 0x214: VA = V4 - VA, VF = !borrow
+      0x8B70, // 0x216: VB = V7
+      0x7C01, // 0x218: VC += 0x01
+      0x5C00, // 0x21A: skip if VC == V0
+      0x1204, // 0x21C: jump to 0x204
+      0x9340, // 0x21E: skip if V3 != V4
+      0x1204, // 0x220: jump to 0x204
+      0x1204  // 0x222: jump to 0x204
+    });
+  }
+
+  // Recurses 16 calls deep (the classic stack limit), unwinds, and repeats.
+  std::vector<char> makeCallRom() {
+    return assemble({
+      0x6010, // 0x200: V0 = 16
+      0x2206, // 0x202: call 0x206
+      0x1200, // 0x204: jump to 0x200
+      0x70FF, // 0x206: V0 -= 1
+      0x3000, // 0x208: skip if V0 == 0
+      0x2206, // 0x20A: call 0x206
+      0x00EE  // 0x20C: return
+    });
+  }
+
+  // Tiles the whole screen with 8x15 sprites (the last row wraps), then
+  // clears it and starts over.
+  std::vector<char> makeDrawRom() {
+    auto rom = assemble({
+      0xA21E, // 0x200: I = sprite
+      0x6100, // 0x202: V1 = 0
+      0x6200, // 0x204: V2 = 0
+      0xD12F, // 0x206: draw 8x15 at (V1, V2)
+      0x7108, // 0x208: V1 += 8
+      0x3140, // 0x20A: skip if V1 == 64
+      0x1206, // 0x20C: jump to 0x206
+      0x6100, // 0x20E: V1 = 0
+      0x720F, // 0x210: V2 += 15
+      0x322D, // 0x212: skip if V2 == 45
+      0x1206, // 0x214: jump to 0x206
+      0x6200, // 0x216: V2 = 0
+      0x00E0, // 0x218: clear screen
+      0x1206, // 0x21A: jump to 0x206
+      0x0000  // 0x21C: padding
+    });
+
+    // 0x21E: a 15-row checkerboard-ish sprite.
+    for(int row = 0; row < 15; row++) {
+      rom.push_back(static_cast<char>(row % 2 == 0 ? 0xAA : 0x55));
+    }
+
+    return rom;
+  }
+
+  std::vector<char> makeMemoryRom() {
+    return assemble({
+      0x7A07, // 0x200: VA += 7
+      0xA300, // 0x202: I = 0x300
+      0xFA33, // 0x204: BCD of VA at I
+      0xF265, // 0x206: load V0..V2 from I
+      0xA310, // 0x208: I = 0x310
+      0xFF55, // 0x20A: store V0..VF at I
+      0xFF65, // 0x20C: load V0..VF from I
+      0xF01E, // 0x20E: I += V0
+      0xF133, // 0x210: BCD of V1 at I
+      0x1200  // 0x212: jump to 0x200
+    });
+  }
+
+  // Rewrites the immediate of the instruction at 0x20A on every pass.
+  std::vector<char> makeSelfModifyingRom() {
+    return assemble({
+      0xA20B, // 0x200: I = 0x20B (low byte of the instruction at 0x20A)
+      0xF065, // 0x202: V0 = memory[I]
+      0x7001, // 0x204: V0 += 1
+      0xF055, // 0x206: memory[I] = V0
+      0x8210, // 0x208: V2 = V1
+      0x7100, // 0x20A: V1 += NN, where NN is rewritten above
+      0x1200  // 0x20C: jump to 0x200
+    });
+  }
+
+  const std::vector<StressRom> & getStressRoms() {
+    static const std::vector<StressRom> roms {
+      { "alu", "register arithmetic, shifts and compare-skips", makeAluRom() },
+      { "calls", "call/return recursion to a depth of 16", makeCallRom() },
+      { "draw", "full-screen 8x15 sprite blits and clears", makeDrawRom() },
+      { "memory", "BCD, bulk register load/store and I arithmetic", makeMemoryRom() },
+      { "selfmodify", "rewrites its own instruction stream every pass", makeSelfModifyingRom() }
+    };
+
+    return roms;
+  }
+}
\ No newline at end of file
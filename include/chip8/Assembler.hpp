@@ -0,0 +1,35 @@
+#pragma once
+#include "chip8/Types.hpp"
+#include "chip8/Constants.hpp"
+#include <string>
+#include <vector>
+
+namespace chip8 {
+
+  // Assembles source written in the disassembler's syntax (see OpcodeInfo
+  // in Decoder.hpp), one statement per line, into the bytes of a rom that
+  // loads at origin. Mnemonics, registers and directives are case
+  // insensitive; labels and constants are not.
+  //
+  //   ; a comment runs to the end of the line
+  //   SPEED  EQU 4             ; a constant
+  //   start: LD V1, SPEED      ; a label, optionally followed by a statement
+  //          LD I, sprite
+  //          DRW V0, V1, sprite.end - sprite
+  //          JP $              ; $ is the statement's own address
+  //   sprite:
+  //          DB 0xF0, 0b10010000, 0x90, 0x90, 0xF0
+  //   sprite.end:
+  //          DW 0x1234, start  ; big-endian words
+  //          DB "text", 0      ; strings are their bytes
+  //          ORG 0x400         ; zero-fill up to an address
+  //          LD I, LONG far    ; XO-CHIP's F000 NNNN, four bytes
+  //
+  // Operands are expressions: decimal, 0x hex or 0b binary numbers, labels,
+  // constants and $, added and subtracted. Labels can be used before
+  // they're defined; EQU and ORG values can only use names defined above
+  // them. Byte operands accept -128 to 255, so "ADD V1, -1" works.
+  //
+  // Throws std::runtime_error naming the first line in error.
+  std::vector<Byte> assemble(const std::string & source, Address origin = PROGRAM_START_ADDRESS);
+}
\ No newline at end of file
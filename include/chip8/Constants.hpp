@@ -1,111 +1,315 @@
 #pragma once
+#include <array>
 #include <cstdint>
 #include <vector>
 #include "chip8/Types.hpp"
 
+// The fonts' bytes, shared by the font arrays below and the initial memory
+// image in Functions.cpp so that both are plain constant data.
+
+// 4x5 pixel hex digits 0-F.
+#define CHIP8_FONT_BYTES \
+  0b11110000, \
+  0b10010000, \
+  0b10010000, \
+  0b10010000, \
+  0b11110000, \
+  \
+  0b00100000, \
+  0b01100000, \
+  0b00100000, \
+  0b00100000, \
+  0b01110000, \
+  \
+  0b11110000, \
+  0b00010000, \
+  0b11110000, \
+  0b10000000, \
+  0b11110000, \
+  \
+  0b11110000, \
+  0b00010000, \
+  0b11110000, \
+  0b00010000, \
+  0b11110000, \
+  \
+  0b10010000, \
+  0b10010000, \
+  0b11110000, \
+  0b00010000, \
+  0b00010000, \
+  \
+  0b11110000, \
+  0b10000000, \
+  0b11110000, \
+  0b00010000, \
+  0b11110000, \
+  \
+  0b11110000, \
+  0b10000000, \
+  0b11110000, \
+  0b10010000, \
+  0b11110000, \
+  \
+  0b11110000, \
+  0b00010000, \
+  0b00100000, \
+  0b01000000, \
+  0b01000000, \
+  \
+  0b11110000, \
+  0b10010000, \
+  0b11110000, \
+  0b10010000, \
+  0b11110000, \
+  \
+  0b11110000, \
+  0b10010000, \
+  0b11110000, \
+  0b00010000, \
+  0b11110000, \
+  \
+  0b11110000, \
+  0b10010000, \
+  0b11110000, \
+  0b10010000, \
+  0b10010000, \
+  \
+  0b11100000, \
+  0b10010000, \
+  0b11100000, \
+  0b10010000, \
+  0b11100000, \
+  \
+  0b11110000, \
+  0b10000000, \
+  0b10000000, \
+  0b10000000, \
+  0b11110000, \
+  \
+  0b11100000, \
+  0b10010000, \
+  0b10010000, \
+  0b10010000, \
+  0b11100000, \
+  \
+  0b11110000, \
+  0b10000000, \
+  0b11110000, \
+  0b10000000, \
+  0b11110000, \
+  \
+  0b11110000, \
+  0b10000000, \
+  0b11110000, \
+  0b10000000, \
+  0b10000000
+
+// SUPER-CHIP's 8x10 pixel hex digits 0-F.
+#define CHIP8_BIG_FONT_BYTES \
+  0b11111111, \
+  0b11111111, \
+  0b11000011, \
+  0b11000011, \
+  0b11000011, \
+  0b11000011, \
+  0b11000011, \
+  0b11000011, \
+  0b11111111, \
+  0b11111111, \
+  \
+  0b00011000, \
+  0b01111000, \
+  0b01111000, \
+  0b00011000, \
+  0b00011000, \
+  0b00011000, \
+  0b00011000, \
+  0b00011000, \
+  0b11111111, \
+  0b11111111, \
+  \
+  0b11111111, \
+  0b11111111, \
+  0b00000011, \
+  0b00000011, \
+  0b11111111, \
+  0b11111111, \
+  0b11000000, \
+  0b11000000, \
+  0b11111111, \
+  0b11111111, \
+  \
+  0b11111111, \
+  0b11111111, \
+  0b00000011, \
+  0b00000011, \
+  0b11111111, \
+  0b11111111, \
+  0b00000011, \
+  0b00000011, \
+  0b11111111, \
+  0b11111111, \
+  \
+  0b11000011, \
+  0b11000011, \
+  0b11000011, \
+  0b11000011, \
+  0b11111111, \
+  0b11111111, \
+  0b00000011, \
+  0b00000011, \
+  0b00000011, \
+  0b00000011, \
+  \
+  0b11111111, \
+  0b11111111, \
+  0b11000000, \
+  0b11000000, \
+  0b11111111, \
+  0b11111111, \
+  0b00000011, \
+  0b00000011, \
+  0b11111111, \
+  0b11111111, \
+  \
+  0b11111111, \
+  0b11111111, \
+  0b11000000, \
+  0b11000000, \
+  0b11111111, \
+  0b11111111, \
+  0b11000011, \
+  0b11000011, \
+  0b11111111, \
+  0b11111111, \
+  \
+  0b11111111, \
+  0b11111111, \
+  0b00000011, \
+  0b00000011, \
+  0b00000110, \
+  0b00001100, \
+  0b00011000, \
+  0b00011000, \
+  0b00011000, \
+  0b00011000, \
+  \
+  0b11111111, \
+  0b11111111, \
+  0b11000011, \
+  0b11000011, \
+  0b11111111, \
+  0b11111111, \
+  0b11000011, \
+  0b11000011, \
+  0b11111111, \
+  0b11111111, \
+  \
+  0b11111111, \
+  0b11111111, \
+  0b11000011, \
+  0b11000011, \
+  0b11111111, \
+  0b11111111, \
+  0b00000011, \
+  0b00000011, \
+  0b11111111, \
+  0b11111111, \
+  \
+  0b01111110, \
+  0b11111111, \
+  0b11000011, \
+  0b11000011, \
+  0b11000011, \
+  0b11111111, \
+  0b11111111, \
+  0b11000011, \
+  0b11000011, \
+  0b11000011, \
+  \
+  0b11111100, \
+  0b11111100, \
+  0b11000011, \
+  0b11000011, \
+  0b11111100, \
+  0b11111100, \
+  0b11000011, \
+  0b11000011, \
+  0b11111100, \
+  0b11111100, \
+  \
+  0b00111100, \
+  0b11111111, \
+  0b11000011, \
+  0b11000000, \
+  0b11000000, \
+  0b11000000, \
+  0b11000000, \
+  0b11000011, \
+  0b11111111, \
+  0b00111100, \
+  \
+  0b11111100, \
+  0b11111110, \
+  0b11000011, \
+  0b11000011, \
+  0b11000011, \
+  0b11000011, \
+  0b11000011, \
+  0b11000011, \
+  0b11111110, \
+  0b11111100, \
+  \
+  0b11111111, \
+  0b11111111, \
+  0b11000000, \
+  0b11000000, \
+  0b11111111, \
+  0b11111111, \
+  0b11000000, \
+  0b11000000, \
+  0b11111111, \
+  0b11111111, \
+  \
+  0b11111111, \
+  0b11111111, \
+  0b11000000, \
+  0b11000000, \
+  0b11111111, \
+  0b11111111, \
+  0b11000000, \
+  0b11000000, \
+  0b11000000, \
+  0b11000000
+
 namespace chip8 {
   const std::size_t RAM_SIZE = 4096;
+  const std::size_t XO_CHIP_RAM_SIZE = 65536;
+  const std::size_t AUDIO_PATTERN_SIZE = 16;
+  const Byte DEFAULT_PITCH = 64; // XO-CHIP's 4000Hz playback rate
   const std::size_t REGISTER_COUNT = 16;
+  const std::size_t KEY_COUNT = 16;
+  const std::size_t STACK_SIZE = 16;
+  const std::size_t CACHE_LINE_SIZE = 64;
   const Instruction HIGH_BYTE_MASK = 0xFF00;
   const std::size_t HIGH_BYTE_SHIFT = 8;
   const Instruction LOW_BYTE_MASK = 0x00FF;
   const Address ADDRESS_BYTE_MASK = 0x0FFF;
   const Address PROGRAM_START_ADDRESS = 512;
-  const std::vector<Byte> FONT_DATA { {
-    0b11110000,
-    0b10010000,
-    0b10010000,
-    0b10010000,
-    0b11110000,
-
-    0b00100000,
-    0b01100000,
-    0b00100000,
-    0b00100000,
-    0b01110000,
-
-    0b11110000,
-    0b00010000,
-    0b11110000,
-    0b10000000,
-    0b11110000,
-
-    0b11110000,
-    0b00010000,
-    0b11110000,
-    0b00010000,
-    0b11110000,
-
-    0b10010000,
-    0b10010000,
-    0b11110000,
-    0b00010000,
-    0b00010000,
-
-    0b11110000,
-    0b10000000,
-    0b11110000,
-    0b00010000,
-    0b11110000,
-
-    0b11110000,
-    0b10000000,
-    0b11110000,
-    0b10010000,
-    0b11110000,
-
-    0b11110000,
-    0b00010000,
-    0b00100000,
-    0b01000000,
-    0b01000000,
-
-    0b11110000,
-    0b10010000,
-    0b11110000,
-    0b10010000,
-    0b11110000,
-
-    0b11110000,
-    0b10010000,
-    0b11110000,
-    0b00010000,
-    0b11110000,
-
-    0b11110000,
-    0b10010000,
-    0b11110000,
-    0b10010000,
-    0b10010000,
-
-    0b11100000,
-    0b10010000,
-    0b11100000,
-    0b10010000,
-    0b11100000,
-
-    0b11110000,
-    0b10000000,
-    0b10000000,
-    0b10000000,
-    0b11110000,
-
-    0b11100000,
-    0b10010000,
-    0b10010000,
-    0b10010000,
-    0b11100000,
+  const std::size_t DISPLAY_WIDTH = 64;
+  const std::size_t DISPLAY_HEIGHT = 32;
+  const std::size_t HI_RES_DISPLAY_WIDTH = 128;
+  const std::size_t HI_RES_DISPLAY_HEIGHT = 64;
+  const std::size_t FONT_GLYPH_SIZE = 5;
+  const std::size_t BIG_FONT_GLYPH_SIZE = 10;
+  const Address FONT_ADDRESS = 0;
+  const Address BIG_FONT_ADDRESS = 16 * FONT_GLYPH_SIZE; // right after the small font
 
-    0b11110000,
-    0b10000000,
-    0b11110000,
-    0b10000000,
-    0b11110000,
+  constexpr ByteArray<16 * FONT_GLYPH_SIZE> FONT_DATA { { CHIP8_FONT_BYTES } };
+  constexpr ByteArray<16 * BIG_FONT_GLYPH_SIZE> BIG_FONT_DATA { { CHIP8_BIG_FONT_BYTES } };
 
-    0b11110000,
-    0b10000000,
-    0b11110000,
-    0b10000000,
-    0b10000000
-  } };
+  // Memory as a VM starts: both fonts, then zeroes. Built by the compiler
+  // (see Functions.cpp) and aligned so copying it is a straight block copy.
+  extern const ByteArray<RAM_SIZE> INITIAL_MEMORY;
 }
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+#include "chip8/Types.hpp"
+#include "chip8/Constants.hpp"
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace chip8 {
+
+  enum class EdgeKind {
+    Fallthrough, // the next instruction, including after a call returns
+    Jump,        // 1NNN
+    Branch,      // a skip that was taken
+    Call         // 2NNN; the block also falls through to the return address
+  };
+
+  struct Edge {
+    Address target;
+    EdgeKind kind;
+  };
+
+  // A run of instructions that is only entered at start and only left after
+  // its last instruction.
+  struct BasicBlock {
+    Address start;
+    Address end; // one past the last instruction
+    std::size_t instructionCount;
+    std::vector<Edge> successors;
+    bool endsInReturn;        // 00EE
+    bool endsInComputedJump;  // BNNN, whose target depends on V0
+    bool endsInInvalid;       // 0NNN or an instruction nothing decodes
+    bool hasSelfModifyingStore;
+    bool hasUnresolvedStore;  // stores through an I set outside the block
+  };
+
+  // What buildControlFlowGraph found. Addresses of individual instructions
+  // are kept for the findings a reader will want to go and look at.
+  struct ControlFlowGraph {
+    Address entry;
+    bool xoChip;
+    std::map<Address, BasicBlock> blocks; // by start address
+    std::set<Address> subroutines;        // 2NNN targets
+    std::vector<Address> computedJumps;   // BNNN instructions
+    std::vector<Address> selfModifyingStores; // stores that hit code
+    std::vector<Address> unresolvedStores;    // stores through an unknown I
+  };
+
+  // Follows every path from entry: jumps, both sides of skips, calls and the
+  // instruction after them. Computed jumps end a path, since their targets
+  // aren't known until the rom runs. A store (FX33, FX55, 5XY2) is
+  // self-modifying when I was set earlier in its block (ANNN, F000 NNNN) to
+  // a range that overlaps an instruction the walk reached. In XO-CHIP mode
+  // F000 NNNN is four bytes long and skips step over all of it.
+  ControlFlowGraph buildControlFlowGraph(const Memory & memory, Address entry = PROGRAM_START_ADDRESS, bool xoChip = false);
+
+  const char * getEdgeKindName(EdgeKind kind);
+
+  // A Graphviz digraph: one node per block, dashed edges for calls.
+  void writeDot(const ControlFlowGraph & graph, std::ostream & out);
+  void writeJson(const ControlFlowGraph & graph, std::ostream & out);
+}
\ No newline at end of file
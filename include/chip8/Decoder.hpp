@@ -0,0 +1,115 @@
+#pragma once
+#include "chip8/Types.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace chip8 {
+
+  // One entry per ops:: handler that can be reached from execute(), plus a
+  // catch-all for instructions that no handler accepts.
+  enum class OpcodeFamily : std::size_t {
+    clearScreen,
+    returnFromSubroutine,
+    callProgramAtAddress,
+    scrollDown,
+    scrollUp,
+    scrollRight,
+    scrollLeft,
+    disableHighResolution,
+    enableHighResolution,
+    jump,
+    callSubroutine,
+    skipIfEquals,
+    skipIfNotEquals,
+    skipIfVxEqualsVy,
+    storeVxToVy,
+    loadVxToVy,
+    setVx,
+    addToVx,
+    setVxToVy,
+    orVxVy,
+    andVxVy,
+    xorVxVy,
+    addVxVyUpdateCarry,
+    subtractVxVyUpdateCarry,
+    rightshiftVx,
+    subtractVxFromVyUpdateCarry,
+    leftshiftVx,
+    skipIfVxNotEqualsVy,
+    setIToAddress,
+    jumpPlusV0,
+    randomVxModNn,
+    blit,
+    skipIfKeyIsPressed,
+    skipIfKeyIsNotPressed,
+    setIToLongAddress,
+    selectPlanes,
+    loadAudioPattern,
+    setVxToDelayTimer,
+    waitForKeyPress,
+    setDelayTimer,
+    setSoundTimer,
+    setPitch,
+    addVxToI,
+    setIToCharacter,
+    setIToBigCharacter,
+    storeBcdOfVx,
+    storeV0ToVx,
+    loadV0ToVx,
+    unknown
+  };
+
+  const std::size_t OPCODE_FAMILY_COUNT = static_cast<std::size_t>(OpcodeFamily::unknown) + 1;
+
+  // How a family is encoded and written. An instruction belongs to the
+  // family when its bits under mask equal value, unless a family with a
+  // narrower pattern (more bits in its mask) claims it too.
+  //
+  // syntax is the assembly form, with placeholders for the operands:
+  //   %x, %y  the X and Y nibbles as one hex digit, as in "V%x"
+  //   %k      the X nibble in decimal
+  //   %n      the last nibble in decimal
+  //   %b      the low byte, 0xNN
+  //   %a      the low 12 bits, 0xNNN
+  //   %l      the word following the instruction, 0xNNNN (F000 NNNN)
+  //   %w      the whole instruction, 0xNNNN
+  struct OpcodeInfo {
+    const char * name; // the ops:: handler
+    Instruction mask;
+    Instruction value;
+    const char * syntax;
+  };
+
+  // In OpcodeFamily order.
+  extern const OpcodeInfo OPCODE_INFO[OPCODE_FAMILY_COUNT];
+
+  inline const OpcodeInfo & getOpcodeInfo(OpcodeFamily family) {
+    return OPCODE_INFO[static_cast<std::size_t>(family)];
+  }
+
+  inline const char * getOpcodeFamilyName(OpcodeFamily family) {
+    return getOpcodeInfo(family).name;
+  }
+
+  // The family of every instruction with a zero X nibble, by top nibble
+  // and low byte, worked out from the OpcodeInfo patterns by the compiler.
+  // It's constant-initialised, so it's ready before any code runs, static
+  // initialisers in other files included.
+  extern const std::array<std::array<std::uint8_t, 0x100>, 0x10> OPCODE_FAMILIES;
+
+  // execute() dispatches through this, so classify() and everything built
+  // on it decode exactly as the interpreter does. Only the 0NNN and FNNN
+  // patterns pin X (00E0, F000, ...), so when the X-less family's pattern
+  // doesn't match, the instruction falls to the family beneath it.
+  inline OpcodeFamily classify(Instruction instruction) {
+    const auto family = OPCODE_FAMILIES[instruction >> 12][instruction & 0xFF];
+    const auto & info = OPCODE_INFO[family];
+
+    if((instruction & info.mask) == info.value) {
+      return static_cast<OpcodeFamily>(family);
+    }
+
+    return instruction < 0x1000 ? OpcodeFamily::callProgramAtAddress : OpcodeFamily::unknown;
+  }
+}
\ No newline at end of file
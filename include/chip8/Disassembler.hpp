@@ -0,0 +1,53 @@
+#pragma once
+#include "chip8/Types.hpp"
+#include <array>
+#include <cstddef>
+#include <string>
+
+namespace chip8 {
+
+  // The longest text one instruction disassembles to, e.g.
+  // "LD I, LONG 0x1234", without a terminator.
+  const std::size_t DISASSEMBLY_MAX_LENGTH = 24;
+
+  // The longest line of a listing, with its newline: a four digit address,
+  // four bytes and the longest text.
+  const std::size_t LISTING_LINE_MAX_LENGTH = 8 + 11 + DISASSEMBLY_MAX_LENGTH + 1;
+
+  struct Disassembly {
+    std::array<char, DISASSEMBLY_MAX_LENGTH + 1> text; // terminated
+    std::size_t length;
+
+    const char * c_str() const {
+      return text.data();
+    }
+  };
+
+  // The instruction in the assembly syntax of its OpcodeInfo. Instructions
+  // no handler accepts come out as "DW 0xNNNN". F000 NNNN takes its address
+  // from longAddress, since it is the word after the instruction.
+  Disassembly disassemble(Instruction instruction, Instruction longAddress = 0);
+
+  // The same text written to out, which needs room for
+  // DISASSEMBLY_MAX_LENGTH characters. Returns how many were written; out
+  // isn't terminated. Nothing is allocated, so it suits formatting traces
+  // of millions of instructions.
+  std::size_t disassemble(Instruction instruction, Instruction longAddress, char * out);
+
+  // Appends a listing of size bytes loaded at origin to out, one line per
+  // instruction with its address and bytes:
+  //
+  //   0x200  6E05       LD VE, 0x05
+  //
+  // F000 NNNN takes four bytes, as it does when executed, and an odd byte
+  // at the end is listed as "DB 0xNN". out is grown once up front, not per
+  // instruction.
+  void disassemble(const Byte * data, std::size_t size, Address origin, std::string & out);
+
+  // Appends the bytes as source that chip8::assemble, given the same
+  // origin, turns back into exactly the same bytes: an ORG line, then one
+  // statement per line with no address or byte columns. Words the syntax
+  // can't reproduce bit for bit (5XY1, say, which reads as SE V%x, V%y) and
+  // an F000 cut off by the end are written as DW, an odd last byte as DB.
+  void disassembleSource(const Byte * data, std::size_t size, Address origin, std::string & out);
+}
\ No newline at end of file
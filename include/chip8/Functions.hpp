@@ -1,6 +1,7 @@
 #pragma once
 #include "chip8/Types.hpp"
 #include "chip8/Constants.hpp"
+#include "chip8/MemoryView.hpp"
 #include <climits>
 #include <tuple>
 #include <type_traits>
@@ -14,6 +15,23 @@ namespace chip8 {
   void cycle(VirtualMachine & vm);
   void reset(VirtualMachine & vm);
 
+  // Counts the delay and sound timers down by one. Call this at 60Hz.
+  void updateTimers(VirtualMachine & vm);
+
+  // Switches the VM to XO-CHIP: memory grows to 64KB and skips step over the
+  // four byte F000 NNNN instruction. Call before loading a rom.
+  void enableXoChip(VirtualMachine & vm);
+
+  static_assert((RAM_SIZE & (RAM_SIZE - 1)) == 0 && (XO_CHIP_RAM_SIZE & (XO_CHIP_RAM_SIZE - 1)) == 0,
+    "memory sizes must be powers of two for wrapAddress");
+
+  // Memory is RAM_SIZE or XO_CHIP_RAM_SIZE bytes, both powers of two, so an
+  // address that runs off the end (I + n, or PC near the top in XO-CHIP
+  // mode) wraps back to the start instead of leaving the buffer.
+  inline std::size_t wrapAddress(const MemoryView & memory, std::size_t address) {
+    return address & (memory.size() - 1);
+  }
+
   inline bool matchesMask(const Instruction ins, const Instruction mask) {
     return (ins & mask) == mask;
   }
@@ -67,6 +85,42 @@ namespace chip8 {
 
   void printGraphicsBufferToConsole(VirtualMachine & vm);
 
-  void loadRomData(VirtualMachine & vm, const std::vector<char> & file);
+  // Why a rom did or didn't load. CannotOpen and CannotRead are only
+  // reported by loaders that read files themselves, e.g. host::loadRomFile.
+  enum class LoadStatus {
+    Loaded,
+    CannotOpen,
+    CannotRead,
+    Empty,
+    TooLarge
+  };
+
+  const char * describe(LoadStatus status);
+
+  // Whether a rom of size bytes would load: Loaded, Empty or TooLarge.
+  LoadStatus checkRomSize(const VirtualMachine & vm, std::size_t size);
+
+  // Copies a rom into memory at PROGRAM_START_ADDRESS. Roms that don't fit
+  // in the VM's memory (4KB, or 64KB with XO-CHIP) are rejected and memory
+  // is left untouched.
+  LoadStatus loadRomData(VirtualMachine & vm, const char * data, std::size_t size);
+  LoadStatus loadRomData(VirtualMachine & vm, const std::vector<char> & file);
+  // VMs start with FONT_DATA and BIG_FONT_DATA already in memory; these
+  // replace the small font with another one.
+  void loadFontData(VirtualMachine & vm, const Byte * data, std::size_t size);
   void loadFontData(VirtualMachine & vm, const std::vector<Byte> & data);
+
+  template <std::size_t N>
+  void loadFontData(VirtualMachine & vm, const ByteArray<N> & data) {
+    loadFontData(vm, data.data(), N);
+  }
+
+  // Builds the memory a VM starts with for a rom: the fonts, then the rom at
+  // PROGRAM_START_ADDRESS. Only as long as it needs to be; the rest of
+  // memory is zero.
+  Memory buildMemoryImage(const char * rom, std::size_t size);
+
+  // Initialises memory from an image with a single copy, zeroing the rest,
+  // so it stands in for loadFontData and loadRomData together.
+  LoadStatus loadMemoryImage(VirtualMachine & vm, const Memory & image);
 }
\ No newline at end of file
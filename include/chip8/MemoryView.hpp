@@ -0,0 +1,77 @@
+#pragma once
+#include "chip8/Types.hpp"
+#include <algorithm>
+#include <cstddef>
+
+namespace chip8 {
+  // A VM's memory as instructions see it: size() bytes starting at data().
+  // It doesn't own them. VirtualMachine points it at its own RAM_SIZE bytes,
+  // or at a separate XO_CHIP_RAM_SIZE buffer once XO-CHIP is enabled, so
+  // only XO-CHIP VMs allocate. Being just a pointer and a size, it fits in
+  // the VM's hot cache line where the buffer itself couldn't.
+  class MemoryView {
+  private:
+    Byte * bytes;
+    std::size_t length;
+
+  public:
+    MemoryView()
+      : bytes{nullptr}
+      , length{0}
+    {
+
+    }
+
+    MemoryView(Byte * bytes, std::size_t length)
+      : bytes{bytes}
+      , length{length}
+    {
+
+    }
+
+    Byte & operator[](std::size_t address) {
+      return bytes[address];
+    }
+
+    const Byte & operator[](std::size_t address) const {
+      return bytes[address];
+    }
+
+    std::size_t size() const {
+      return length;
+    }
+
+    Byte * data() {
+      return bytes;
+    }
+
+    const Byte * data() const {
+      return bytes;
+    }
+
+    Byte * begin() {
+      return bytes;
+    }
+
+    const Byte * begin() const {
+      return bytes;
+    }
+
+    Byte * end() {
+      return bytes + length;
+    }
+
+    const Byte * end() const {
+      return bytes + length;
+    }
+  };
+
+  // Compares contents, not where they are.
+  inline bool operator==(const MemoryView & a, const MemoryView & b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+  }
+
+  inline bool operator!=(const MemoryView & a, const MemoryView & b) {
+    return !(a == b);
+  }
+}
\ No newline at end of file
@@ -10,10 +10,19 @@ namespace chip8 {
     void clearScreen(VirtualMachine & vm, Instruction instruction);
     void returnFromSubroutine(VirtualMachine & vm, Instruction instruction);
     void callProgramAtAddress(VirtualMachine & vm, Instruction instruction);
+    void scrollDown(VirtualMachine & vm, Instruction instruction);
+    void scrollUp(VirtualMachine & vm, Instruction instruction);
+    void scrollRight(VirtualMachine & vm, Instruction instruction);
+    void scrollLeft(VirtualMachine & vm, Instruction instruction);
+    void disableHighResolution(VirtualMachine & vm, Instruction instruction);
+    void enableHighResolution(VirtualMachine & vm, Instruction instruction);
     void callSubroutine(VirtualMachine & vm, Instruction instruction);
     void skipIfEquals(VirtualMachine & vm, Instruction instruction);
     void skipIfNotEquals(VirtualMachine & vm, Instruction instruction);
+    void disambiguate0x5(VirtualMachine & vm, Instruction instruction);
     void skipIfVxEqualsVy(VirtualMachine & vm, Instruction instruction);
+    void storeVxToVy(VirtualMachine & vm, Instruction instruction);
+    void loadVxToVy(VirtualMachine & vm, Instruction instruction);
     void setVx(VirtualMachine & vm, Instruction instruction);
     void addToVx(VirtualMachine & vm, Instruction instruction);
     void disambiguate0x8(VirtualMachine & vm, Instruction instruction);
@@ -31,16 +40,22 @@ namespace chip8 {
     void jumpPlusV0(VirtualMachine & vm, Instruction instruction);
     void randomVxModNn(VirtualMachine & vm, Instruction instruction);
     void blit(VirtualMachine & vm, Instruction instruction);
+    void blitHighResolution(VirtualMachine & vm, Instruction instruction);
     void disambiguate0xE(VirtualMachine & vm, Instruction instruction);
     void skipIfKeyIsPressed(VirtualMachine & vm, Instruction instruction);
     void skipIfKeyIsNotPressed(VirtualMachine & vm, Instruction instruction);
     void disambiguate0xF(VirtualMachine & vm, Instruction instruction);
+    void setIToLongAddress(VirtualMachine & vm, Instruction instruction);
+    void selectPlanes(VirtualMachine & vm, Instruction instruction);
+    void loadAudioPattern(VirtualMachine & vm, Instruction instruction);
     void setVxToDelayTimer(VirtualMachine & vm, Instruction instruction);
     void waitForKeyPress(VirtualMachine & vm, Instruction instruction);
     void setDelayTimer(VirtualMachine & vm, Instruction instruction);
     void setSoundTimer(VirtualMachine & vm, Instruction instruction);
+    void setPitch(VirtualMachine & vm, Instruction instruction);
     void addVxToI(VirtualMachine & vm, Instruction instruction);
     void setIToCharacter(VirtualMachine & vm, Instruction instruction);
+    void setIToBigCharacter(VirtualMachine & vm, Instruction instruction);
     void storeBcdOfVx(VirtualMachine & vm, Instruction instruction);
     void storeV0ToVx(VirtualMachine & vm, Instruction instruction);
     void loadV0ToVx(VirtualMachine & vm, Instruction instruction);
@@ -0,0 +1,35 @@
+#pragma once
+#include "chip8/Types.hpp"
+#include "chip8/Constants.hpp"
+#include "chip8/Decoder.hpp"
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+namespace chip8 {
+  struct VirtualMachine;
+
+  struct Profile {
+    std::array<std::uint64_t, OPCODE_FAMILY_COUNT> opcodeCounts;
+    // One count per byte of memory, sized from the VM on the first profiled
+    // cycle: 4096 entries for CHIP-8, 65536 only once XO-CHIP is in use.
+    std::vector<std::uint64_t> addressCounts;
+    std::uint64_t cycles;
+    std::uint64_t keypressWaitCycles;
+
+    Profile()
+      : opcodeCounts{}
+      , addressCounts{}
+      , cycles{0}
+      , keypressWaitCycles{0}
+    {
+
+    }
+  };
+
+  // Same as cycle(vm), but records what was executed (and where) in profile.
+  void cycle(VirtualMachine & vm, Profile & profile);
+
+  void printProfileReport(const Profile & profile, std::ostream & out, std::size_t addressLimit = 32);
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+#include "chip8/Types.hpp"
+#include "chip8/Constants.hpp"
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+namespace chip8 {
+  struct VirtualMachine;
+  struct ControlFlowGraph;
+
+  // What a block reports back. instructionsRun is all of its instructions
+  // unless one waited for a key or stored over code, which end the block
+  // there; storedOverCode is set by the latter even when it was the block's
+  // last instruction, so the runner knows to recheck memory.
+  struct RecompiledBlockResult {
+    std::size_t instructionsRun;
+    bool storedOverCode;
+  };
+
+  // Runs one basic block lifted to C++ by writeRecompiledRom and leaves
+  // programCounter at the next instruction to run.
+  using RecompiledBlockFunction = RecompiledBlockResult (*)(VirtualMachine & vm);
+
+  struct RecompiledBlock {
+    Address start;
+    std::size_t instructionCount;
+    RecompiledBlockFunction run;
+  };
+
+  // Bytes of memory that hold instructions the blocks were lifted from.
+  struct RecompiledRange {
+    Address start;
+    Address end; // one past the last byte
+  };
+
+  // What a generated file defines for one rom. The blocks are only valid
+  // while memory still holds the code they were lifted from, which
+  // RecompiledRunner checks before trusting them.
+  struct RecompiledRom {
+    const char * name;
+    bool xoChip;
+    Address firstAddress;
+    Address endAddress;
+    const Byte * code;                       // memory[firstAddress, endAddress)
+    const RecompiledRange * ranges;
+    std::size_t rangeCount;
+    const RecompiledBlock * const * blocks;  // by address - firstAddress; null where no block starts
+  };
+
+  // Whether count bytes stored from address overlap the rom's code.
+  bool touchesCode(const RecompiledRom & rom, std::size_t address, std::size_t count);
+
+  // Whether vm can run the rom's blocks: same mode, and its memory still
+  // holds the code they were lifted from.
+  bool matchesCode(const RecompiledRom & rom, const VirtualMachine & vm);
+
+  // Runs a recompiled rom on a VM. Whether memory still holds the rom's
+  // code is checked when the runner is made and after any store that could
+  // have overwritten it; call check() after changing memory outside of
+  // run(), e.g. after loading another rom.
+  class RecompiledRunner {
+  private:
+    const RecompiledRom & rom;
+    bool usingBlocks;
+
+  public:
+    RecompiledRunner(const RecompiledRom & rom, const VirtualMachine & vm);
+
+    void check(const VirtualMachine & vm);
+
+    // Same as calling cycle(vm) cycles times. Whole blocks run where the
+    // program counter lands on one and the budget has room for it; anything
+    // else (unknown jump targets, a block cut short by the budget, code
+    // that was overwritten) falls back to the interpreter.
+    void run(VirtualMachine & vm, std::size_t cycles);
+
+    bool isUsingBlocks() const {
+      return usingBlocks;
+    }
+  };
+
+  // Writes a C++ source file defining `const RecompiledRom name` from the
+  // graph of the rom in memory: one function per basic block, compiled
+  // with the project and linked against the emulator core.
+  void writeRecompiledRom(const ControlFlowGraph & graph, const Memory & memory, const std::string & name, std::ostream & out);
+}
\ No newline at end of file
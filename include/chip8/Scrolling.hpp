@@ -0,0 +1,31 @@
+#pragma once
+#include "chip8/Types.hpp"
+#include <cstddef>
+
+namespace chip8 {
+
+  // Scroll primitives for a single bit plane. Rows move with a memmove and
+  // the exposed rows are cleared; pixels move by shifting whole words,
+  // carrying across the two words of a high resolution row. Where SSE2 is
+  // available two low resolution rows, or one high resolution row, are
+  // shifted per instruction.
+  void scrollPlaneDown(GraphicsBuffer & plane, std::size_t rows);
+  void scrollPlaneDown(HiResGraphicsBuffer & plane, std::size_t rows);
+  void scrollPlaneUp(GraphicsBuffer & plane, std::size_t rows);
+  void scrollPlaneUp(HiResGraphicsBuffer & plane, std::size_t rows);
+
+  // Pixel counts must be less than 64.
+  void scrollPlaneRight(GraphicsBuffer & plane, unsigned int pixels);
+  void scrollPlaneRight(HiResGraphicsBuffer & plane, unsigned int pixels);
+  void scrollPlaneLeft(GraphicsBuffer & plane, unsigned int pixels);
+  void scrollPlaneLeft(HiResGraphicsBuffer & plane, unsigned int pixels);
+
+  // Plain word-at-a-time versions of the horizontal scrolls, kept as the
+  // reference the vectorised ones are tested and benchmarked against.
+  namespace scalar {
+    void scrollPlaneRight(GraphicsBuffer & plane, unsigned int pixels);
+    void scrollPlaneRight(HiResGraphicsBuffer & plane, unsigned int pixels);
+    void scrollPlaneLeft(GraphicsBuffer & plane, unsigned int pixels);
+    void scrollPlaneLeft(HiResGraphicsBuffer & plane, unsigned int pixels);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+#include "chip8/Types.hpp"
+#include "chip8/Constants.hpp"
+
+namespace chip8 {
+  // The call stack: STACK_SIZE return addresses stored in place, so that
+  // calls and returns never allocate and the stack sits inside the VM.
+  class Stack {
+  private:
+    std::array<Address, STACK_SIZE> entries;
+    Byte depth;
+
+  public:
+    Stack()
+      : entries{}
+      , depth{0}
+    {
+      entries.fill(0);
+    }
+
+    bool empty() const {
+      return depth == 0;
+    }
+
+    bool full() const {
+      return depth == STACK_SIZE;
+    }
+
+    std::size_t size() const {
+      return depth;
+    }
+
+    Address top() const {
+      return entries[depth - 1];
+    }
+
+    void push(Address address) {
+      entries[depth] = address;
+      depth += 1;
+    }
+
+    void pop() {
+      depth -= 1;
+    }
+  };
+}
\ No newline at end of file
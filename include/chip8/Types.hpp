@@ -3,7 +3,7 @@
 #include <bitset>
 #include <cstdint>
 #include <functional>
-#include <stack>
+#include <vector>
 
 namespace chip8 {
   using Byte = std::uint8_t;
@@ -11,8 +11,12 @@ namespace chip8 {
   using Address = std::uint16_t;
   using Instruction = std::uint16_t;
   using Opcode = std::uint16_t;
-  using Stack = std::stack<Address>;
+  using Memory = std::vector<Byte>;
   using GraphicsBuffer = std::array<std::uint64_t, 32>;
+  // SUPER-CHIP's 128x64 screen: each row is two words, the left half of the
+  // row in [0] and the right half in [1], most significant bit leftmost.
+  using HiResGraphicsRow = std::array<std::uint64_t, 2>;
+  using HiResGraphicsBuffer = std::array<HiResGraphicsRow, 64>;
   using RandomNumberGenerator = std::function<Byte(Byte seed)>;
   using KeyboardInputs = std::bitset<16>;
 
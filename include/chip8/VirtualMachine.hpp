@@ -1,41 +1,127 @@
 #pragma once
 #include "chip8/Types.hpp"
 #include "chip8/Constants.hpp"
+#include "chip8/MemoryView.hpp"
+#include "chip8/Stack.hpp"
 #include "chip8/Timers.hpp"
+#include <memory>
 
 namespace chip8 {
-  struct VirtualMachine {
-    ByteArray<RAM_SIZE> memory;
+  // The state that nearly every instruction reads or writes. It is the base
+  // of VirtualMachine so that it fills the VM's first cache line, ahead of
+  // the larger and rarely touched members.
+  struct HotState {
     ByteArray<REGISTER_COUNT> registers;
     Address programCounter;
     Address I; // address register
     Timers timers;
-    Stack stack;
-    RandomNumberGenerator rng;
-    GraphicsBuffer graphics;
-    bool graphicsAreDirty;
-    KeyboardInputs keyboard;
     bool awaitingKeypress;
     Byte nextKeypressRegister;
+    Byte selectedPlanes; // XO-CHIP FN01 bit mask; graphics is plane 1
+    bool highResolution; // SUPER-CHIP 128x64 mode; draws go to hiResGraphics
+    bool graphicsAreDirty;
+    bool xoChip;
+    KeyboardInputs keyboard;
+    MemoryView memory; // RAM_SIZE bytes, or XO_CHIP_RAM_SIZE once XO-CHIP is enabled
 
-    VirtualMachine()
-      : memory{}
-      , registers{}
+    HotState()
+      : registers{}
       , programCounter{0}
       , I{0}
       , timers{}
-      , stack{}
-      , rng{[](Byte seed) { return 7; }}
-      , graphics{}
-      , graphicsAreDirty{false}
-      , keyboard{}
       , awaitingKeypress{false}
       , nextKeypressRegister{0}
+      , selectedPlanes{1}
+      , highResolution{false}
+      , graphicsAreDirty{false}
+      , xoChip{false}
+      , keyboard{}
+      , memory{}
     {
-      memory.fill(0);
       registers.fill(0);
-      graphics.fill(0);
       keyboard.reset();
     }
   };
+
+  static_assert(sizeof(HotState) <= CACHE_LINE_SIZE, "HotState must fit in one cache line");
+
+  struct alignas(CACHE_LINE_SIZE) VirtualMachine : HotState {
+    // Used by calls, returns and the odd instruction; two cache lines.
+    Stack stack;
+    ByteArray<AUDIO_PATTERN_SIZE> audioPattern;
+    Byte pitch;
+    RandomNumberGenerator rng;
+    std::unique_ptr<ByteArray<XO_CHIP_RAM_SIZE>> xoChipRam; // allocated by enableXoChip
+
+    // Only touched by draws and scrolls, and by the host once per frame.
+    alignas(CACHE_LINE_SIZE) GraphicsBuffer graphics;
+    HiResGraphicsBuffer hiResGraphics;
+    GraphicsBuffer graphicsPlane2;
+    HiResGraphicsBuffer hiResGraphicsPlane2;
+
+    // A CHIP-8 VM's memory, in place so that constructing one is a copy of
+    // INITIAL_MEMORY rather than an allocation. Unused under XO-CHIP.
+    alignas(CACHE_LINE_SIZE) ByteArray<RAM_SIZE> ram;
+
+    VirtualMachine()
+      : HotState{}
+      , stack{}
+      , audioPattern{}
+      , pitch{DEFAULT_PITCH}
+      , rng{[](Byte seed) { return 7; }}
+      , xoChipRam{}
+      , graphics{}
+      , hiResGraphics{}
+      , graphicsPlane2{}
+      , hiResGraphicsPlane2{}
+      , ram(INITIAL_MEMORY)
+    {
+      graphics.fill(0);
+      hiResGraphics.fill(HiResGraphicsRow{ { 0, 0 } });
+      graphicsPlane2.fill(0);
+      hiResGraphicsPlane2.fill(HiResGraphicsRow{ { 0, 0 } });
+      audioPattern.fill(0);
+      attachMemory();
+    }
+
+    VirtualMachine(const VirtualMachine & other)
+      : VirtualMachine{}
+    {
+      *this = other;
+    }
+
+    // Member by member, since memory has to point into this VM's own buffer
+    // rather than the other's.
+    VirtualMachine & operator=(const VirtualMachine & other) {
+      static_cast<HotState &>(*this) = other;
+      stack = other.stack;
+      audioPattern = other.audioPattern;
+      pitch = other.pitch;
+      rng = other.rng;
+      xoChipRam.reset(other.xoChipRam ? new ByteArray<XO_CHIP_RAM_SIZE>(*other.xoChipRam) : nullptr);
+      graphics = other.graphics;
+      hiResGraphics = other.hiResGraphics;
+      graphicsPlane2 = other.graphicsPlane2;
+      hiResGraphicsPlane2 = other.hiResGraphicsPlane2;
+      ram = other.ram;
+      attachMemory();
+
+      return *this;
+    }
+
+    // Points memory at whichever buffer is in use.
+    void attachMemory() {
+      if(xoChipRam) {
+        memory = MemoryView{xoChipRam->data(), xoChipRam->size()};
+      } else {
+        memory = MemoryView{ram.data(), ram.size()};
+      }
+    }
+  };
+
+  static_assert(
+    sizeof(VirtualMachine) == 3 * CACHE_LINE_SIZE
+      + 2 * sizeof(GraphicsBuffer) + 2 * sizeof(HiResGraphicsBuffer) + RAM_SIZE,
+    "VirtualMachine should be one line of hot state, two of cold state, the graphics buffers and memory"
+  );
 }
\ No newline at end of file
@@ -1,38 +1,73 @@
 #pragma once
+#include "host/EmulationClock.hpp"
+#include "host/Keymap.hpp"
+#include "host/ToneGenerator.hpp"
 #include <SDL.h>
+#include <array>
+#include <cstdint>
+#include <iosfwd>
 #include <memory>
 
 namespace chip8 {
   struct VirtualMachine;
+  struct Profile;
 }
 
 namespace host {
 
   using SDL2WindowPtr = std::unique_ptr<SDL_Window, decltype(&SDL_DestroyWindow)>;
   using SDL2RendererPtr = std::unique_ptr<SDL_Renderer, decltype(&SDL_DestroyRenderer)>;
+  using SDL2GameControllerPtr = std::unique_ptr<SDL_GameController, decltype(&SDL_GameControllerClose)>;
   const int SCREEN_WIDTH {640};
   const int SCREEN_HEIGHT {480};
+  const Uint32 MAX_CATCH_UP_MILLISECONDS {250};
+
+  // Colours for the four XO-CHIP plane combinations; CHIP-8 and SUPER-CHIP
+  // roms only ever use the first two.
+  const std::size_t PALETTE_SIZE {4};
+  const std::array<std::array<Uint8, 3>, PALETTE_SIZE> PALETTE { {
+    { { 0, 0, 0 } },
+    { { 255, 255, 255 } },
+    { { 170, 170, 170 } },
+    { { 85, 85, 85 } }
+  } };
+
+  // Loads a keymap config, resolving binding names with SDL's own scancode
+  // and gamepad button names.
+  Keymap readKeymap(std::istream & config);
 
   class Application {
   private:
     chip8::VirtualMachine & vm;
+    chip8::Profile * profile;
     SDL2WindowPtr window;
     SDL2RendererPtr renderer;
+    SDL2GameControllerPtr gamepad;
+    Keymap keymap;
     SDL_Event event;
     SDL_Rect pixelRect;
     bool quit;
     bool paused;
     bool enableSound;
+    std::uint16_t audioBufferFrames;
+    EmulationClock clock;
+    Uint32 lastTicks;
+    std::uint64_t targetTick;
 
   public:
-    Application(chip8::VirtualMachine & vm);
+    Application(chip8::VirtualMachine & vm, const Keymap & keymap, chip8::Profile * profile = nullptr, std::uint16_t audioBufferFrames = DEFAULT_AUDIO_BUFFER_FRAMES);
     ~Application();
 
     int run();
 
     void handleEvents();
-    void updateEmulator();
+    void handleEvent();
+    void waitForEvent();
     void updateScreen();
+
+  private:
+    void setKey(std::int8_t key, bool pressed, Uint32 timestamp);
+    void drawRow(std::uint64_t plane1, std::uint64_t plane2, std::size_t left, std::size_t y, int pixelSize);
   };
 
 }
\ No newline at end of file
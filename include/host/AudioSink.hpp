@@ -0,0 +1,46 @@
+#pragma once
+#include "chip8/Constants.hpp"
+#include "chip8/Types.hpp"
+#include "host/GatedTone.hpp"
+#include <cstdint>
+
+namespace chip8 {
+  struct VirtualMachine;
+}
+
+namespace host {
+
+  const int AUDIO_SAMPLE_RATE {48000};
+
+  // The buzzer's tone: the same 120Hz square wave the original sine-based
+  // generator produced.
+  const double TONE_FREQUENCY {120.0};
+  const std::int8_t TONE_AMPLITUDE {5};
+
+  // Where the buzzer goes: an audio device (ToneGenerator) or a file
+  // (WavAudioSink). Callers report the sound state along with the emulated
+  // cycle it changed on; only actual changes reach the backend, as one
+  // SoundEvent describing the whole new state.
+  class AudioSink {
+  private:
+    SoundEvent state;
+
+  protected:
+    // event.frame is left for the backend to fill in from its own clock.
+    virtual void queue(const SoundEvent & event, std::uint64_t cycle) = 0;
+
+  public:
+    AudioSink();
+    virtual ~AudioSink();
+
+    void setSounding(bool on, std::uint64_t cycle);
+
+    // Switches to (or updates) XO-CHIP pattern playback.
+    void setPattern(const chip8::ByteArray<chip8::AUDIO_PATTERN_SIZE> & pattern, chip8::Byte pitch, std::uint64_t cycle);
+  };
+
+  // Reports the VM's current sound state to the sink: the pattern for
+  // XO-CHIP VMs, and whether the sound timer is running (when enabled).
+  void updateAudio(AudioSink & sink, const chip8::VirtualMachine & vm, bool enabled, std::uint64_t cycle);
+
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+#include "chip8/Types.hpp"
+#include <bitset>
+#include <cstdint>
+#include <deque>
+
+namespace chip8 {
+  struct VirtualMachine;
+  struct Profile;
+}
+
+namespace host {
+
+  // Emulated time is counted in ticks of 1/3000s, the finest grain that
+  // both the 500Hz CPU and the 60Hz timers land on exactly.
+  const std::uint64_t CLOCK_TICKS_PER_SECOND = 3000;
+  const std::uint64_t CLOCK_TICKS_PER_CYCLE = CLOCK_TICKS_PER_SECOND / 500;
+  const std::uint64_t CLOCK_TICKS_PER_TIMER_UPDATE = CLOCK_TICKS_PER_SECOND / 60;
+
+  struct InputEvent {
+    std::uint64_t tick;
+    chip8::Byte key;
+    bool pressed;
+  };
+
+  // Runs a VM against emulated time. The host says how far time has got
+  // (advanceTo) and the clock executes every cycle and timer update due
+  // before then, applying queued input on the tick it was stamped with. So
+  // however irregularly the host catches up, the rom sees each key change
+  // at the same point in its execution, which is also what makes a
+  // recording of stamped input replay identically.
+  class EmulationClock {
+  private:
+    std::deque<InputEvent> input;
+    std::bitset<16> pressedSinceCycle;
+    std::uint64_t now;
+    std::uint64_t cycles;
+
+    bool applyInput(chip8::VirtualMachine & vm);
+    void fastForward(std::uint64_t target, chip8::VirtualMachine & vm, chip8::Profile * profile);
+
+  public:
+    EmulationClock();
+
+    // Events must arrive in the order they happened. Ones stamped earlier
+    // than the last queued event, or in the past, are moved up to the
+    // earliest tick they can still apply on.
+    void queueInput(std::uint64_t tick, chip8::Byte key, bool pressed);
+
+    // Executes every tick before target. A key released on the same tick
+    // it was pressed is held down for one cycle first, so a tap between two
+    // host updates is never lost. Time spent waiting on Fx0A is skipped in
+    // one step rather than cycle by cycle.
+    void advanceTo(std::uint64_t target, chip8::VirtualMachine & vm, chip8::Profile * profile = nullptr);
+
+    std::uint64_t getNow() const {
+      return now;
+    }
+
+    // The tick of the first 60Hz timer update after now. One due on now
+    // itself runs with the next advanceTo; counting it here would have a
+    // host waiting for it wake straight away, over and over.
+    std::uint64_t getNextTimerUpdate() const {
+      return (now / CLOCK_TICKS_PER_TIMER_UPDATE + 1) * CLOCK_TICKS_PER_TIMER_UPDATE;
+    }
+
+    std::uint64_t getCycles() const {
+      return cycles;
+    }
+
+    bool hasPendingInput() const {
+      return !input.empty();
+    }
+  };
+
+}
\ No newline at end of file
@@ -1,8 +1,20 @@
 #pragma once
+#include "chip8/Functions.hpp"
 #include <fstream>
 #include <iostream>
+#include <string>
 #include <vector>
 
+namespace chip8 {
+  struct VirtualMachine;
+}
+
 namespace host {
+  // Throws std::runtime_error if the file can't be read.
   const std::vector<char> readFileAsChar(const std::string & filePath);
+
+  // Checks the rom's size against the VM's memory, then reads it straight
+  // into memory with no intermediate buffer. Reports why it failed rather
+  // than throwing.
+  chip8::LoadStatus loadRomFile(chip8::VirtualMachine & vm, const std::string & filePath);
 }
\ No newline at end of file
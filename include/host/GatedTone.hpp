@@ -0,0 +1,80 @@
+#pragma once
+#include "chip8/Constants.hpp"
+#include "chip8/Types.hpp"
+#include "host/PatternWave.hpp"
+#include "host/SpscQueue.hpp"
+#include "host/SquareWave.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace host {
+
+  // Switches the tone on or off at frame, counted in frames rendered since
+  // the GatedTone was created. With usePattern set, the tone from then on is
+  // the XO-CHIP audio pattern at the given pitch instead of the square wave.
+  struct SoundEvent {
+    std::uint64_t frame;
+    bool on;
+    bool usePattern;
+    chip8::Byte pitch;
+    chip8::ByteArray<chip8::AUDIO_PATTERN_SIZE> pattern;
+  };
+
+  const std::size_t SOUND_EVENT_QUEUE_SIZE = 256;
+
+  using SoundEventQueue = SpscQueue<SoundEvent, SOUND_EVENT_QUEUE_SIZE>;
+
+  // A square wave gated by sound events. The emulation thread pushes events
+  // and the audio thread renders. Each event takes effect on exactly the
+  // frame it names, so on/off edges land at sample accuracy however the
+  // events line up with audio buffers. Neither side takes a lock.
+  class GatedTone {
+  private:
+    SoundEventQueue events;
+    SquareWave wave;
+    PatternWave patternWave;
+    std::uint64_t framesRendered;
+    std::uint64_t maximumLead;
+    bool sounding;
+    bool usePattern;
+
+    void apply(const SoundEvent & event);
+
+    void renderSpan(std::int8_t * stream, std::size_t frames, std::size_t channels);
+
+  public:
+    // Events more than maximumLead frames past the end of the buffer being
+    // rendered are treated as due now; this bounds how far clock drift
+    // between producer and consumer can delay the tone.
+    GatedTone(int sampleRate, double frequency, std::int8_t amplitude, std::uint64_t maximumLead);
+
+    // Producer side. Returns false if the queue is full and the event was
+    // dropped.
+    bool push(const SoundEvent & event) {
+      return events.push(event);
+    }
+
+    // Consumer side: fills frames of interleaved signed 8-bit samples,
+    // applying every event that falls inside them.
+    void render(std::int8_t * stream, std::size_t frames, std::size_t channels);
+
+    // Retunes both the square wave and the pattern's pitch table.
+    void setSampleRate(int sampleRate, double frequency) {
+      wave.setFrequency(sampleRate, frequency);
+      patternWave.setSampleRate(sampleRate);
+    }
+
+    std::uint64_t getFramesRendered() const {
+      return framesRendered;
+    }
+
+    bool isSounding() const {
+      return sounding;
+    }
+
+    bool isPlayingPattern() const {
+      return usePattern;
+    }
+  };
+
+}
\ No newline at end of file
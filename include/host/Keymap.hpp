@@ -0,0 +1,74 @@
+#pragma once
+#include "chip8/Types.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+
+namespace host {
+
+  // Covers SDL_NUM_SCANCODES and SDL_CONTROLLER_BUTTON_MAX without needing
+  // SDL here, so the keymap can be tested on its own.
+  const std::size_t KEYMAP_SCANCODE_COUNT = 512;
+  const std::size_t KEYMAP_GAMEPAD_BUTTON_COUNT = 32;
+  const std::int8_t UNBOUND_KEY = -1;
+
+  // Turns a binding's name into a scancode or gamepad button number, or -1 if
+  // the name isn't known. The application passes SDL's own name lookups.
+  using BindingResolver = std::function<int(const std::string &)>;
+
+  // The original hard-coded layout: the 4x4 block from 1 to V, row by row, is
+  // CHIP-8 keys 0 to F. Plus a d-pad and two face buttons for gamepads.
+  const char * const DEFAULT_KEYMAP =
+    "0 = 1\n"
+    "1 = 2\n"
+    "2 = 3\n"
+    "3 = 4\n"
+    "4 = Q, pad:b\n"
+    "5 = W, pad:dpup\n"
+    "6 = E, pad:a\n"
+    "7 = R, pad:dpleft\n"
+    "8 = A, pad:dpdown\n"
+    "9 = S, pad:dpright\n"
+    "A = D\n"
+    "B = F\n"
+    "C = Z\n"
+    "D = X\n"
+    "E = C\n"
+    "F = V\n";
+
+  // Maps scancodes and gamepad buttons to CHIP-8 keys with one table lookup.
+  // Any number of bindings can share a CHIP-8 key.
+  //
+  // The config format is one line per CHIP-8 key, a hex digit, then `=` and
+  // a comma-separated list of bindings: scancode names as SDL spells them
+  // ("Q", "Keypad 8", "Left Shift") or gamepad buttons prefixed with `pad:`
+  // ("pad:a", "pad:dpup"). `#` starts a comment. Keys a config doesn't
+  // mention are unbound.
+  class Keymap {
+  private:
+    std::array<std::int8_t, KEYMAP_SCANCODE_COUNT> scancodes;
+    std::array<std::int8_t, KEYMAP_GAMEPAD_BUTTON_COUNT> buttons;
+
+  public:
+    Keymap();
+
+    // Throws std::runtime_error naming the offending line on bad input.
+    void load(std::istream & config, const BindingResolver & scancodeNamed, const BindingResolver & buttonNamed);
+
+    void bindScancode(int scancode, chip8::Byte key);
+    void bindButton(int button, chip8::Byte key);
+
+    // The CHIP-8 key bound to the scancode or button, or UNBOUND_KEY.
+    std::int8_t keyForScancode(int scancode) const {
+      return (scancode >= 0 && static_cast<std::size_t>(scancode) < scancodes.size()) ? scancodes[scancode] : UNBOUND_KEY;
+    }
+
+    std::int8_t keyForButton(int button) const {
+      return (button >= 0 && static_cast<std::size_t>(button) < buttons.size()) ? buttons[button] : UNBOUND_KEY;
+    }
+  };
+
+}
\ No newline at end of file
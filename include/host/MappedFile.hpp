@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace host {
+
+  // A read-only view of a whole file. It is memory-mapped where the platform
+  // supports it, so nothing is copied until the caller copies from getData().
+  // Elsewhere the file is read into a buffer. isOpen() is false when the file
+  // couldn't be opened or mapped; an empty file is open with a size of 0.
+  class MappedFile {
+  private:
+    const char * data;
+    std::size_t size;
+    bool open;
+    bool mapped;
+
+    void close();
+
+  public:
+    explicit MappedFile(const std::string & path);
+    ~MappedFile();
+
+    MappedFile(MappedFile && other);
+    MappedFile & operator=(MappedFile && other);
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+
+    bool isOpen() const {
+      return open;
+    }
+
+    const char * getData() const {
+      return data;
+    }
+
+    std::size_t getSize() const {
+      return size;
+    }
+  };
+
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+#include "chip8/Constants.hpp"
+#include "chip8/Types.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace host {
+
+  const std::size_t PATTERN_BITS = chip8::AUDIO_PATTERN_SIZE * 8;
+  const std::size_t PATTERN_BITS_SHIFT = 32 - 7; // log2(PATTERN_BITS) integer bits of phase
+  const std::size_t PITCH_COUNT = 256;
+
+  // XO-CHIP plays its pattern at 4000 * 2^((pitch - 64) / 48) bits per second.
+  const double PATTERN_PLAYBACK_RATE = 4000.0;
+
+  // Plays an XO-CHIP audio pattern, a 128-bit loop of 1-bit samples, at any
+  // of the 256 pitches, resampled to the device rate. The phase increment for
+  // every pitch is precomputed when the sample rate is set and the pattern is
+  // expanded to one sample per bit when loaded, so generate is a lookup and
+  // an add per frame and never allocates. Doesn't depend on SDL.
+  class PatternWave {
+  private:
+    std::array<std::uint32_t, PITCH_COUNT> increments;
+    std::array<std::int8_t, PATTERN_BITS> levels;
+    std::int8_t amplitude;
+    std::uint32_t phase;
+    std::uint32_t phaseIncrement;
+    chip8::Byte pitch;
+
+  public:
+    PatternWave(int sampleRate, std::int8_t amplitude);
+
+    // Rebuilds the pitch table; call when the device's rate is known.
+    void setSampleRate(int sampleRate);
+
+    void setPattern(const chip8::ByteArray<chip8::AUDIO_PATTERN_SIZE> & pattern);
+    void setPitch(chip8::Byte pitch);
+
+    // Writes frames of interleaved signed 8-bit samples, the same sample on
+    // every channel of a frame. Set bits play +amplitude, clear bits
+    // -amplitude, most significant bit of the first byte first.
+    void generate(std::int8_t * stream, std::size_t frames, std::size_t channels);
+
+    std::uint32_t getPhase() const {
+      return phase;
+    }
+
+    std::uint32_t getPhaseIncrement() const {
+      return phaseIncrement;
+    }
+  };
+
+}
\ No newline at end of file
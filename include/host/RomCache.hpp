@@ -0,0 +1,53 @@
+#pragma once
+#include "chip8/Functions.hpp"
+#include "chip8/Types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace host {
+
+  // A rom's initial memory image (see chip8::buildMemoryImage), shared
+  // read-only between every VM started from it.
+  using RomImage = std::shared_ptr<const chip8::Memory>;
+
+  std::uint64_t hashRom(const char * data, std::size_t size);
+
+  // Loads each rom once per process. Files are read the first time their
+  // path is asked for; images are keyed by a hash of the rom's contents, so
+  // the same rom under several paths (or handed over from memory) is stored
+  // once. Starting a VM from a cached image is then one memcpy via
+  // chip8::loadMemoryImage. Roms too large for even XO-CHIP's 64KB memory
+  // are never cached. Safe to use from several threads.
+  class RomCache {
+  private:
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, RomImage> byPath;
+    std::unordered_multimap<std::uint64_t, RomImage> byHash;
+
+    RomImage intern(const char * data, std::size_t size);
+
+  public:
+    RomCache();
+
+    RomCache(const RomCache &) = delete;
+    RomCache & operator=(const RomCache &) = delete;
+
+    // The process-wide cache.
+    static RomCache & shared();
+
+    // On success sets image and returns Loaded; otherwise CannotOpen,
+    // CannotRead, Empty or TooLarge. Failures aren't cached.
+    chip8::LoadStatus get(const std::string & filePath, RomImage & image);
+
+    // For roms that are already in memory: Loaded, Empty or TooLarge.
+    chip8::LoadStatus get(const char * data, std::size_t size, RomImage & image);
+
+    // How many distinct roms are cached.
+    std::size_t size() const;
+  };
+
+}
\ No newline at end of file
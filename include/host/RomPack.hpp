@@ -0,0 +1,64 @@
+#pragma once
+#include "chip8/Functions.hpp"
+#include "host/MappedFile.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace chip8 {
+  struct VirtualMachine;
+}
+
+namespace host {
+
+  //
+  // A rom pack holds many roms in one file so a corpus can be opened once
+  // instead of file by file. All integers are little-endian:
+  //
+  //   header        "C8PK", uint32 version, uint32 rom count, uint32 reserved
+  //   offset table  rom count + 1 uint64s; rom i is the bytes from offset i
+  //                 up to offset i + 1, measured from the start of the file
+  //   roms          the roms' contents, back to back
+  //
+  const char ROM_PACK_MAGIC[4] = { 'C', '8', 'P', 'K' };
+  const std::uint32_t ROM_PACK_VERSION = 1;
+  const std::size_t ROM_PACK_HEADER_SIZE = 16;
+  const std::size_t ROM_PACK_OFFSET_SIZE = 8;
+
+  // A rom's bytes inside a pack. Only valid while the pack is open.
+  struct RomSpan {
+    const char * data;
+    std::size_t size;
+  };
+
+  // Writes a pack of the given roms. Returns false if the stream fails.
+  bool writeRomPack(std::ostream & out, const std::vector<RomSpan> & roms);
+
+  // A pack opened for reading. The file is memory-mapped, so roms are only
+  // paged in as they're used and getRom() is O(1). The header and offset
+  // table are checked once on opening; the constructor throws
+  // std::runtime_error if the file can't be read or isn't a valid pack.
+  class RomPack {
+  private:
+    MappedFile file;
+    std::size_t romCount;
+
+    std::uint64_t getOffset(std::size_t index) const;
+
+  public:
+    explicit RomPack(const std::string & filePath);
+
+    std::size_t size() const {
+      return romCount;
+    }
+
+    // Throws std::runtime_error if index is out of range.
+    RomSpan getRom(std::size_t index) const;
+
+    // Hands rom index straight from the mapping to chip8::loadRomData.
+    chip8::LoadStatus loadRom(chip8::VirtualMachine & vm, std::size_t index) const;
+  };
+
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace host {
+
+  // A bounded, lock-free queue for exactly one producer thread and one
+  // consumer thread. Neither side ever blocks: push fails when the queue is
+  // full and pop/peek fail when it is empty. The two indices live on their
+  // own cache lines so the threads don't contend for them.
+  template <typename T, std::size_t Capacity>
+  class SpscQueue {
+  private:
+    static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+    static const std::size_t MASK = Capacity - 1;
+
+    alignas(64) std::atomic<std::size_t> head; // next item to consume
+    alignas(64) std::atomic<std::size_t> tail; // next free slot
+    alignas(64) std::array<T, Capacity> items;
+
+  public:
+    SpscQueue()
+      : head{0}
+      , tail{0}
+      , items{}
+    {
+
+    }
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue & operator=(const SpscQueue &) = delete;
+
+    // Producer only.
+    bool push(const T & item) {
+      const auto currentTail = tail.load(std::memory_order_relaxed);
+
+      if(currentTail - head.load(std::memory_order_acquire) == Capacity) {
+        return false;
+      }
+
+      items[currentTail & MASK] = item;
+      tail.store(currentTail + 1, std::memory_order_release);
+
+      return true;
+    }
+
+    // Consumer only. Copies the oldest item without removing it.
+    bool peek(T & item) const {
+      const auto currentHead = head.load(std::memory_order_relaxed);
+
+      if(currentHead == tail.load(std::memory_order_acquire)) {
+        return false;
+      }
+
+      item = items[currentHead & MASK];
+
+      return true;
+    }
+
+    // Consumer only.
+    bool pop(T & item) {
+      if(!peek(item)) {
+        return false;
+      }
+
+      head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+      return true;
+    }
+
+    // Either side; only a snapshot while the other side is running.
+    bool empty() const {
+      return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+    static std::size_t capacity() {
+      return Capacity;
+    }
+  };
+
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace host {
+
+  const std::size_t WAVE_TABLE_BITS = 8;
+  const std::size_t WAVE_TABLE_SIZE = 1 << WAVE_TABLE_BITS;
+
+  // A square wave oscillator. One period is precomputed into a table and a
+  // 32-bit phase accumulator walks it, so each sample costs a lookup and an
+  // add. Every instance keeps its own phase. Doesn't depend on SDL, so it can
+  // be tested and benchmarked without an audio device.
+  class SquareWave {
+  private:
+    std::array<std::int8_t, WAVE_TABLE_SIZE> table;
+    std::uint32_t phase;
+    std::uint32_t phaseIncrement;
+
+  public:
+    SquareWave(int sampleRate, double frequency, std::int8_t amplitude);
+
+    void setFrequency(int sampleRate, double frequency);
+
+    // Writes frames of interleaved signed 8-bit samples, the same sample on
+    // every channel of a frame.
+    void generate(std::int8_t * stream, std::size_t frames, std::size_t channels);
+
+    std::uint32_t getPhase() const {
+      return phase;
+    }
+
+    std::uint32_t getPhaseIncrement() const {
+      return phaseIncrement;
+    }
+  };
+
+}
\ No newline at end of file
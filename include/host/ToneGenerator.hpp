@@ -1,27 +1,55 @@
 #pragma once
+#include "host/AudioSink.hpp"
+#include "host/GatedTone.hpp"
 #include <SDL.h>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 
 namespace host {
 
-  class ToneGenerator {
+  const std::uint16_t DEFAULT_AUDIO_BUFFER_FRAMES {4096};
+
+  // The SDL audio device backend. Changes are timestamped with the device's
+  // clock rather than the cycle they're reported on, since the emulator runs
+  // in real time here.
+  class ToneGenerator : public AudioSink {
   private:
+    using Clock = std::chrono::steady_clock;
+
     static void generateTone(void * userData, std::uint8_t * stream, int length);
-    static const int PAUSE_AUDIO = 1;
     static const int UNPAUSE_AUDIO = 0;
 
     SDL_AudioSpec desired;
     SDL_AudioSpec obtained;
     SDL_AudioDeviceID device;
+    GatedTone tone;
+
+    // Written by the audio callback, read by the emulation thread to keep
+    // event timestamps on the audio device's clock.
+    std::atomic<std::uint64_t> framesRendered;
+
+    // Emulation thread only.
+    std::uint64_t anchorFrame;
+    Clock::time_point anchorTime;
+
+    std::uint64_t currentFrame();
 
-    bool active;
+  protected:
+    // Queued for the audio callback, which switches the tone at the matching
+    // sample; the device itself keeps running and no SDL audio lock is
+    // taken.
+    void queue(const SoundEvent & event, std::uint64_t cycle) override;
 
   public:
-    ToneGenerator();
+    // Smaller buffers lower the latency between the sound timer starting
+    // and the tone being heard, at the cost of more frequent callbacks.
+    explicit ToneGenerator(std::uint16_t bufferFrames = DEFAULT_AUDIO_BUFFER_FRAMES);
     ~ToneGenerator();
 
-    void activate();
-    void deactivate();
+    // The audio callback holds a pointer to the generator.
+    ToneGenerator(const ToneGenerator &) = delete;
+    ToneGenerator & operator=(const ToneGenerator &) = delete;
   };
 
 }
\ No newline at end of file
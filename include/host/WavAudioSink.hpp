@@ -0,0 +1,51 @@
+#pragma once
+#include "host/AudioSink.hpp"
+#include "host/GatedTone.hpp"
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace host {
+
+  const std::size_t WAV_CHUNK_FRAMES = 4096;
+
+  // Renders the buzzer to a mono 8-bit WAV file instead of a device, for
+  // runs without one. Time is emulated time: each change lands on the frame
+  // matching the cycle it was reported on, so the file is exactly what the
+  // rom asked for however fast the VM actually ran, and two runs of the same
+  // rom produce identical files.
+  class WavAudioSink : public AudioSink {
+  private:
+    std::ofstream file;
+    GatedTone tone;
+    std::array<std::int8_t, WAV_CHUNK_FRAMES> chunk;
+    int sampleRate;
+    std::uint64_t cyclesPerSecond;
+    std::uint64_t framesWritten;
+
+    std::uint64_t frameAt(std::uint64_t cycle) const;
+    void renderTo(std::uint64_t frame);
+    void writeHeader();
+
+  protected:
+    void queue(const SoundEvent & event, std::uint64_t cycle) override;
+
+  public:
+    // Throws std::runtime_error if path can't be opened.
+    WavAudioSink(const std::string & path, std::uint64_t cyclesPerSecond, int sampleRate = AUDIO_SAMPLE_RATE);
+    ~WavAudioSink();
+
+    WavAudioSink(const WavAudioSink &) = delete;
+    WavAudioSink & operator=(const WavAudioSink &) = delete;
+
+    // Renders up to cycle and fixes up the header. Returns false if writing
+    // failed. Calling it again later extends the file.
+    bool finish(std::uint64_t cycle);
+
+    std::uint64_t getFramesWritten() const {
+      return framesWritten;
+    }
+  };
+
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#!/bin/sh
+#
+# Builds a profile-guided optimized emulator and reports what PGO bought.
+#
+#   scripts/pgo-build.sh [build-dir]
+#
+# 1. A plain Release build in <build-dir>-reference, benchmarked as the
+#    reference.
+# 2. <build-dir> configured with CHIP8_PGO=GENERATE; the pgo-train target
+#    runs the training set (bundled roms headless + synthetic stress roms).
+# 3. The same directory reconfigured with CHIP8_PGO=USE and rebuilt. GCC
+#    looks profiles up by object path, so both phases must share a directory.
+# 4. chip8-bench from the PGO build is compared against the reference.
+#
+set -e
+
+SOURCE_DIR=$(cd "$(dirname "$0")/.." && pwd)
+BUILD_DIR=${1:-"$SOURCE_DIR/build-pgo"}
+REFERENCE_DIR="$BUILD_DIR-reference"
+BENCH_FILTER="execute,cycle,fetch,rom:,stress:"
+
+cmake -S "$SOURCE_DIR" -B "$REFERENCE_DIR" -DCMAKE_BUILD_TYPE=Release -DCHIP8_PGO=OFF
+cmake --build "$REFERENCE_DIR" --target chip8-bench
+
+cmake -S "$SOURCE_DIR" -B "$BUILD_DIR" -DCMAKE_BUILD_TYPE=Release -DCHIP8_PGO=GENERATE
+cmake --build "$BUILD_DIR" --target pgo-train
+
+cmake -S "$SOURCE_DIR" -B "$BUILD_DIR" -DCMAKE_BUILD_TYPE=Release -DCHIP8_PGO=USE
+cmake --build "$BUILD_DIR"
+
+"$REFERENCE_DIR/bench/chip8-bench" --filter "$BENCH_FILTER" --output "$REFERENCE_DIR/bench-results.json"
+"$BUILD_DIR/bench/chip8-bench" --filter "$BENCH_FILTER" --output "$BUILD_DIR/bench-results.json" \
+  --compare "$REFERENCE_DIR/bench-results.json"
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+#include "chip8/Decoder.hpp"
+#include "chip8/Functions.hpp"
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+
+// Internal to the core: what ControlFlow.cpp and Recompiler.cpp must agree
+// on. The recompiler's self-modifying code check relies on the same store
+// lengths the graph was built with.
+namespace chip8 {
+  namespace analysis {
+
+    inline bool isStore(OpcodeFamily family) {
+      return family == OpcodeFamily::storeBcdOfVx
+        || family == OpcodeFamily::storeV0ToVx
+        || family == OpcodeFamily::storeVxToVy;
+    }
+
+    // The bytes a store (FX33, FX55, 5XY2) writes from I; zero for any
+    // other instruction.
+    inline std::size_t getStoreLength(OpcodeFamily family, Instruction instruction) {
+      Nibble x, y;
+      std::tie(x, y) = getXY(instruction);
+
+      switch(family) {
+        case OpcodeFamily::storeBcdOfVx:
+          return 3;
+        case OpcodeFamily::storeV0ToVx:
+          return x + 1;
+        case OpcodeFamily::storeVxToVy:
+          return (x <= y ? y - x : x - y) + 1;
+        default:
+          return 0;
+      }
+    }
+
+    // Writes value as 0x and width upper case hex digits.
+    struct Hex {
+      unsigned int value;
+      int width;
+    };
+
+    inline std::ostream & operator<<(std::ostream & out, Hex hex) {
+      const auto flags = out.flags();
+      out << "0x" << std::hex << std::uppercase << std::setw(hex.width) << std::setfill('0') << hex.value;
+      out.flags(flags);
+      out.fill(' ');
+      return out;
+    }
+
+    inline Hex hexAddress(std::size_t address) {
+      return Hex{ static_cast<unsigned int>(address), 3 };
+    }
+
+  }
+}
\ No newline at end of file
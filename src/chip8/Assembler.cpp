@@ -0,0 +1,611 @@
+#include "chip8/Assembler.hpp"
+#include "chip8/Decoder.hpp"
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace chip8 {
+
+  namespace {
+
+    // An operand of one of the syntax strings in Decoder.cpp, split off its
+    // mnemonic, e.g. "V%x" or "LONG %l".
+    struct Template {
+      OpcodeFamily family;
+      std::vector<std::string> operands;
+    };
+
+    using TemplateTable = std::unordered_map<std::string, std::vector<Template>>;
+
+    // An expression waiting for pass two, and the placeholder it fills.
+    struct Field {
+      char placeholder;
+      std::string expression;
+    };
+
+    enum class StatementKind {
+      Instruction,
+      Bytes,
+      Words
+    };
+
+    // What pass one leaves for pass two: where the statement goes, and the
+    // parts of it that can't be encoded until every label is known.
+    struct Statement {
+      std::size_t line;
+      Address address;
+      StatementKind kind;
+      Instruction word; // the instruction with its registers filled in
+      std::vector<Field> fields;
+      std::vector<std::string> data; // DB and DW items
+    };
+
+    using SymbolTable = std::unordered_map<std::string, long>;
+
+    [[noreturn]] void fail(std::size_t line, const std::string & message) {
+      throw std::runtime_error("line " + std::to_string(line) + ": " + message);
+    }
+
+    std::string toUpper(std::string text) {
+      for(auto & c : text) {
+        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+      }
+
+      return text;
+    }
+
+    bool isSpace(char c) {
+      return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    std::string trim(const std::string & text) {
+      std::size_t begin = 0;
+      std::size_t end = text.size();
+
+      while(begin < end && isSpace(text[begin])) {
+        begin++;
+      }
+
+      while(end > begin && isSpace(text[end - 1])) {
+        end--;
+      }
+
+      return text.substr(begin, end - begin);
+    }
+
+    bool isIdentifierStart(char c) {
+      return std::isalpha(static_cast<unsigned char>(c)) || c == '_' || c == '.';
+    }
+
+    bool isIdentifierPart(char c) {
+      return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '.';
+    }
+
+    // Register and operand keywords, which can't name labels or constants.
+    // Called for every name in every operand, so it doesn't allocate.
+    bool isReserved(const std::string & name) {
+      static const char * const KEYWORDS[] = { "I", "DT", "ST", "K", "F", "HF", "B", "LONG" };
+
+      if(name.size() == 2 && (name[0] == 'V' || name[0] == 'v') && std::isxdigit(static_cast<unsigned char>(name[1]))) {
+        return true;
+      }
+
+      for(const auto keyword : KEYWORDS) {
+        std::size_t i = 0;
+
+        while(i < name.size() && keyword[i] && std::toupper(static_cast<unsigned char>(name[i])) == keyword[i]) {
+          i++;
+        }
+
+        if(i == name.size() && !keyword[i]) {
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    bool isSymbol(const std::string & name) {
+      if(name.empty() || !isIdentifierStart(name[0]) || isReserved(name)) {
+        return false;
+      }
+
+      for(const auto c : name) {
+        if(!isIdentifierPart(c)) {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    int getDigitValue(char c) {
+      if(c >= '0' && c <= '9') {
+        return c - '0';
+      }
+
+      c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+      return c >= 'A' && c <= 'F' ? c - 'A' + 10 : 16;
+    }
+
+    // Reads a number at text[i], moving i past it. False if it's malformed
+    // or too large to mean anything as an operand.
+    bool readNumber(const std::string & text, std::size_t & i, long & value) {
+      int base = 10;
+
+      if(text[i] == '0' && i + 1 < text.size() && (text[i + 1] == 'x' || text[i + 1] == 'X')) {
+        base = 16;
+        i += 2;
+      } else if(text[i] == '0' && i + 1 < text.size() && (text[i + 1] == 'b' || text[i + 1] == 'B')) {
+        base = 2;
+        i += 2;
+      }
+
+      const auto start = i;
+      value = 0;
+
+      while(i < text.size() && isIdentifierPart(text[i])) {
+        const auto digit = getDigitValue(text[i]);
+
+        if(digit >= base) {
+          return false;
+        }
+
+        value = value * base + digit;
+
+        if(value > 0xFFFFFF) {
+          return false;
+        }
+
+        i++;
+      }
+
+      return i > start;
+    }
+
+    // Walks an expression: terms separated by + and -, with an optional
+    // leading sign. With symbols, each name is looked up and the value is
+    // returned through value; without, only the shape is checked.
+    bool walkExpression(const std::string & text, const SymbolTable * symbols, Address here, std::size_t line, long & value) {
+      std::size_t i = 0;
+      long sign = 1;
+
+      value = 0;
+
+      while(i < text.size() && isSpace(text[i])) {
+        i++;
+      }
+
+      if(i < text.size() && (text[i] == '+' || text[i] == '-')) {
+        sign = text[i] == '-' ? -1 : 1;
+        i++;
+      }
+
+      while(true) {
+        while(i < text.size() && isSpace(text[i])) {
+          i++;
+        }
+
+        if(i == text.size()) {
+          return false;
+        }
+
+        const auto c = text[i];
+        long term = 0;
+
+        if(c == '$') {
+          term = here;
+          i++;
+        } else if(std::isdigit(static_cast<unsigned char>(c))) {
+          if(!readNumber(text, i, term)) {
+            return false;
+          }
+        } else if(isIdentifierStart(c)) {
+          const auto start = i;
+
+          while(i < text.size() && isIdentifierPart(text[i])) {
+            i++;
+          }
+
+          const auto name = text.substr(start, i - start);
+
+          if(isReserved(name)) {
+            return false;
+          }
+
+          if(symbols) {
+            const auto symbol = symbols->find(name);
+
+            if(symbol == symbols->end()) {
+              fail(line, "unknown symbol '" + name + "'");
+            }
+
+            term = symbol->second;
+          }
+        } else {
+          return false;
+        }
+
+        value += sign * term;
+
+        while(i < text.size() && isSpace(text[i])) {
+          i++;
+        }
+
+        if(i == text.size()) {
+          return true;
+        }
+
+        if(text[i] != '+' && text[i] != '-') {
+          return false;
+        }
+
+        sign = text[i] == '-' ? -1 : 1;
+        i++;
+      }
+    }
+
+    bool isExpression(const std::string & text) {
+      long value;
+      return walkExpression(text, nullptr, 0, 0, value);
+    }
+
+    long evaluate(const std::string & text, const SymbolTable & symbols, Address here, std::size_t line) {
+      long value;
+
+      if(!walkExpression(text, &symbols, here, line, value)) {
+        fail(line, "invalid expression '" + text + "'");
+      }
+
+      return value;
+    }
+
+    long checkRange(long value, long low, long high, std::size_t line) {
+      if(value < low || value > high) {
+        fail(line, std::to_string(value) + " is out of range (" + std::to_string(low) + " to " + std::to_string(high) + ")");
+      }
+
+      return value;
+    }
+
+    // Splits on commas outside string literals, trimming each part.
+    std::vector<std::string> splitOperands(const std::string & text) {
+      std::vector<std::string> operands;
+
+      if(text.empty()) {
+        return operands;
+      }
+
+      bool inString = false;
+      std::size_t start = 0;
+
+      for(std::size_t i = 0; i <= text.size(); i++) {
+        if(i == text.size() || (text[i] == ',' && !inString)) {
+          operands.push_back(trim(text.substr(start, i - start)));
+          start = i + 1;
+        } else if(text[i] == '"') {
+          inString = !inString;
+        }
+      }
+
+      return operands;
+    }
+
+    TemplateTable buildTemplates() {
+      TemplateTable templates;
+
+      for(std::size_t i = 0; i + 1 < OPCODE_FAMILY_COUNT; i++) {
+        const auto family = static_cast<OpcodeFamily>(i);
+        const std::string syntax = getOpcodeInfo(family).syntax;
+        const auto space = syntax.find(' ');
+
+        Template entry{ family, {} };
+
+        if(space != std::string::npos) {
+          entry.operands = splitOperands(syntax.substr(space + 1));
+        }
+
+        templates[syntax.substr(0, space)].push_back(entry);
+      }
+
+      return templates;
+    }
+
+    const TemplateTable & getTemplates() {
+      static const TemplateTable templates = buildTemplates();
+      return templates;
+    }
+
+    // Matches one operand against one operand of a syntax string. Register
+    // nibbles go straight into word; expressions are left in fields.
+    bool matchOperand(const std::string & pattern, const std::string & operand, Instruction & word, std::vector<Field> & fields) {
+      std::size_t i = 0;
+
+      for(std::size_t p = 0; p < pattern.size(); p++) {
+        if(pattern[p] == ' ') {
+          if(i == operand.size() || !isSpace(operand[i])) {
+            return false;
+          }
+
+          while(i < operand.size() && isSpace(operand[i])) {
+            i++;
+          }
+        } else if(pattern[p] != '%') {
+          if(i == operand.size() || std::toupper(static_cast<unsigned char>(operand[i])) != pattern[p]) {
+            return false;
+          }
+
+          i++;
+        } else if(pattern[p + 1] == 'x' || pattern[p + 1] == 'y') {
+          if(i == operand.size() || getDigitValue(operand[i]) > 0xF) {
+            return false;
+          }
+
+          word |= getDigitValue(operand[i]) << (pattern[++p] == 'x' ? 8 : 4);
+          i++;
+        } else {
+          // Every other placeholder takes the rest of the operand.
+          const auto expression = operand.substr(i);
+
+          if(!isExpression(expression)) {
+            return false;
+          }
+
+          fields.push_back(Field{ pattern[p + 1], expression });
+          return true;
+        }
+      }
+
+      return i == operand.size();
+    }
+
+    // Picks the family whose syntax the operands fit. Register operands
+    // never pass for expressions, so "LD V1, V2" and "LD V1, 2" can't
+    // both match.
+    OpcodeFamily matchInstruction(const std::string & mnemonic, const std::vector<std::string> & operands, Statement & statement) {
+      const auto & templates = getTemplates();
+      const auto candidates = templates.find(toUpper(mnemonic));
+
+      if(candidates == templates.end()) {
+        fail(statement.line, "unknown instruction '" + mnemonic + "'");
+      }
+
+      for(const auto & candidate : candidates->second) {
+        if(candidate.operands.size() != operands.size()) {
+          continue;
+        }
+
+        Instruction word = getOpcodeInfo(candidate.family).value;
+        std::vector<Field> fields;
+        bool matched = true;
+
+        for(std::size_t i = 0; i < operands.size() && matched; i++) {
+          matched = matchOperand(candidate.operands[i], operands[i], word, fields);
+        }
+
+        if(matched) {
+          statement.word = word;
+          statement.fields = std::move(fields);
+          return candidate.family;
+        }
+      }
+
+      fail(statement.line, "invalid operands for " + toUpper(mnemonic));
+    }
+
+    bool isString(const std::string & item) {
+      return item.size() >= 2 && item.front() == '"' && item.back() == '"';
+    }
+
+    std::size_t getDataSize(const std::vector<std::string> & items, std::size_t line) {
+      std::size_t size = 0;
+
+      for(const auto & item : items) {
+        if(isString(item)) {
+          size += item.size() - 2;
+        } else if(isExpression(item)) {
+          size += 1;
+        } else {
+          fail(line, "invalid data '" + item + "'");
+        }
+      }
+
+      return size;
+    }
+
+    void defineSymbol(SymbolTable & symbols, const std::string & name, long value, std::size_t line) {
+      if(!isSymbol(name)) {
+        fail(line, "'" + name + "' can't be used as a name");
+      }
+
+      if(!symbols.emplace(name, value).second) {
+        fail(line, "'" + name + "' is already defined");
+      }
+    }
+
+    void writeWord(std::vector<Byte> & rom, std::size_t offset, long value) {
+      rom[offset] = static_cast<Byte>((value >> 8) & 0xFF);
+      rom[offset + 1] = static_cast<Byte>(value & 0xFF);
+    }
+
+    void encodeInstruction(const Statement & statement, const SymbolTable & symbols, std::vector<Byte> & rom, std::size_t offset) {
+      auto word = static_cast<long>(statement.word);
+
+      for(const auto & field : statement.fields) {
+        const auto value = evaluate(field.expression, symbols, statement.address, statement.line);
+
+        switch(field.placeholder) {
+          case 'k':
+            word |= checkRange(value, 0, 0xF, statement.line) << 8;
+            break;
+          case 'n':
+            word |= checkRange(value, 0, 0xF, statement.line);
+            break;
+          case 'b':
+            word |= checkRange(value, -0x80, 0xFF, statement.line) & 0xFF;
+            break;
+          case 'a':
+            word |= checkRange(value, 0, 0xFFF, statement.line);
+            break;
+          case 'l':
+            writeWord(rom, offset + 2, checkRange(value, -0x8000, 0xFFFF, statement.line));
+            break;
+        }
+      }
+
+      writeWord(rom, offset, word);
+    }
+
+    void encodeData(const Statement & statement, const SymbolTable & symbols, std::vector<Byte> & rom, std::size_t offset) {
+      for(const auto & item : statement.data) {
+        if(statement.kind == StatementKind::Words) {
+          writeWord(rom, offset, checkRange(evaluate(item, symbols, statement.address, statement.line), -0x8000, 0xFFFF, statement.line));
+          offset += 2;
+        } else if(isString(item)) {
+          for(std::size_t i = 1; i + 1 < item.size(); i++) {
+            rom[offset++] = static_cast<Byte>(item[i]);
+          }
+        } else {
+          rom[offset++] = static_cast<Byte>(checkRange(evaluate(item, symbols, statement.address, statement.line), -0x80, 0xFF, statement.line));
+        }
+      }
+    }
+
+    // The line without its comment; semicolons in strings don't count.
+    std::string stripComment(const std::string & line) {
+      bool inString = false;
+
+      for(std::size_t i = 0; i < line.size(); i++) {
+        if(line[i] == '"') {
+          inString = !inString;
+        } else if(line[i] == ';' && !inString) {
+          return line.substr(0, i);
+        }
+      }
+
+      return line;
+    }
+
+  }
+
+  std::vector<Byte> assemble(const std::string & source, Address origin) {
+    const long end = 0x10000;
+
+    SymbolTable symbols;
+    std::vector<Statement> statements;
+    long address = origin;
+    std::size_t lineNumber = 0;
+
+    statements.reserve(std::count(source.begin(), source.end(), '\n') + 1);
+
+    // Pass one: every statement's size is known from its syntax alone, so
+    // labels get their addresses here and operands wait for pass two.
+    for(std::size_t lineStart = 0; lineStart < source.size(); ) {
+      auto lineEnd = source.find('\n', lineStart);
+
+      if(lineEnd == std::string::npos) {
+        lineEnd = source.size();
+      }
+
+      lineNumber++;
+      auto line = trim(stripComment(source.substr(lineStart, lineEnd - lineStart)));
+      lineStart = lineEnd + 1;
+
+      // Labels, any number of them, ahead of the statement.
+      while(!line.empty() && isIdentifierStart(line[0])) {
+        std::size_t i = 0;
+
+        while(i < line.size() && isIdentifierPart(line[i])) {
+          i++;
+        }
+
+        if(i == line.size() || line[i] != ':') {
+          break;
+        }
+
+        defineSymbol(symbols, line.substr(0, i), address, lineNumber);
+        line = trim(line.substr(i + 1));
+      }
+
+      if(line.empty()) {
+        continue;
+      }
+
+      std::size_t split = 0;
+
+      while(split < line.size() && !isSpace(line[split])) {
+        split++;
+      }
+
+      const auto head = line.substr(0, split);
+      auto rest = trim(line.substr(split));
+      const auto keyword = toUpper(rest.substr(0, rest.find_first_of(" \t")));
+
+      if(keyword == "EQU") {
+        const auto value = evaluate(trim(rest.substr(3)), symbols, static_cast<Address>(address), lineNumber);
+        defineSymbol(symbols, head, value, lineNumber);
+        continue;
+      }
+
+      const auto directive = toUpper(head);
+      const auto operands = splitOperands(rest);
+      std::size_t size = 2;
+
+      if(directive == "ORG") {
+        if(operands.size() != 1) {
+          fail(lineNumber, "ORG takes one address");
+        }
+
+        address = checkRange(evaluate(operands[0], symbols, static_cast<Address>(address), lineNumber), address, end, lineNumber);
+        continue;
+      }
+
+      Statement statement{ lineNumber, static_cast<Address>(address), StatementKind::Instruction, 0, {}, {} };
+
+      if(directive == "DB" || directive == "DW") {
+        if(operands.empty()) {
+          fail(lineNumber, directive + " needs at least one value");
+        }
+
+        statement.kind = directive == "DB" ? StatementKind::Bytes : StatementKind::Words;
+        statement.data = operands;
+        size = directive == "DB" ? getDataSize(operands, lineNumber) : operands.size() * 2;
+
+        if(statement.kind == StatementKind::Words) {
+          for(const auto & item : operands) {
+            if(!isExpression(item)) {
+              fail(lineNumber, "invalid data '" + item + "'");
+            }
+          }
+        }
+      } else {
+        if(matchInstruction(head, operands, statement) == OpcodeFamily::setIToLongAddress) {
+          size = 4;
+        }
+      }
+
+      if(address + static_cast<long>(size) > end) {
+        fail(lineNumber, "the program runs past 0xFFFF");
+      }
+
+      address += size;
+      statements.push_back(std::move(statement));
+    }
+
+    // Pass two: every label is known, so operands can be evaluated.
+    std::vector<Byte> rom(address - origin, 0);
+
+    for(const auto & statement : statements) {
+      const std::size_t offset = statement.address - origin;
+
+      if(statement.kind == StatementKind::Instruction) {
+        encodeInstruction(statement, symbols, rom, offset);
+      } else {
+        encodeData(statement, symbols, rom, offset);
+      }
+    }
+
+    return rom;
+  }
+}
\ No newline at end of file
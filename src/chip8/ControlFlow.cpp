@@ -0,0 +1,392 @@
+#include "chip8/ControlFlow.hpp"
+#include "AnalysisUtilities.hpp"
+#include "chip8/Decoder.hpp"
+#include "chip8/Functions.hpp"
+#include <algorithm>
+#include <deque>
+#include <iomanip>
+#include <ostream>
+
+namespace chip8 {
+
+  namespace {
+
+    struct Decoded {
+      Instruction instruction;
+      OpcodeFamily family;
+      Address length;
+    };
+
+    bool contains(const Memory & memory, std::size_t address, std::size_t length) {
+      return address + length <= memory.size();
+    }
+
+    Instruction readInstruction(const Memory & memory, std::size_t address) {
+      return static_cast<Instruction>((memory[address] << 8) | memory[address + 1]);
+    }
+
+    Decoded decode(const Memory & memory, Address address, bool xoChip) {
+      const auto instruction = readInstruction(memory, address);
+      auto family = classify(instruction);
+      Address length = 2;
+
+      if(family == OpcodeFamily::setIToLongAddress) {
+        if(xoChip) {
+          length = 4;
+        } else {
+          family = OpcodeFamily::unknown;
+        }
+      }
+
+      return Decoded{ instruction, family, length };
+    }
+
+    bool isSkip(OpcodeFamily family) {
+      switch(family) {
+        case OpcodeFamily::skipIfEquals:
+        case OpcodeFamily::skipIfNotEquals:
+        case OpcodeFamily::skipIfVxEqualsVy:
+        case OpcodeFamily::skipIfVxNotEqualsVy:
+        case OpcodeFamily::skipIfKeyIsPressed:
+        case OpcodeFamily::skipIfKeyIsNotPressed:
+          return true;
+        default:
+          return false;
+      }
+    }
+
+    // Whether the instruction is the last one of its block.
+    bool endsBlock(OpcodeFamily family) {
+      switch(family) {
+        case OpcodeFamily::jump:
+        case OpcodeFamily::callSubroutine:
+        case OpcodeFamily::returnFromSubroutine:
+        case OpcodeFamily::jumpPlusV0:
+        case OpcodeFamily::callProgramAtAddress:
+        case OpcodeFamily::unknown:
+          return true;
+        default:
+          return isSkip(family);
+      }
+    }
+
+    // Where control can go after the instruction at address. Fills nothing
+    // for instructions that leave the walk.
+    void getSuccessors(const Memory & memory, Address address, const Decoded & decoded, bool xoChip, std::vector<Edge> & edges) {
+      const Address next = address + decoded.length;
+
+      switch(decoded.family) {
+        case OpcodeFamily::jump:
+          edges.push_back(Edge{ getAddress(decoded.instruction), EdgeKind::Jump });
+          return;
+
+        case OpcodeFamily::callSubroutine:
+          edges.push_back(Edge{ getAddress(decoded.instruction), EdgeKind::Call });
+          edges.push_back(Edge{ next, EdgeKind::Fallthrough });
+          return;
+
+        case OpcodeFamily::returnFromSubroutine:
+        case OpcodeFamily::jumpPlusV0:
+        case OpcodeFamily::callProgramAtAddress:
+        case OpcodeFamily::unknown:
+          return;
+
+        default:
+          break;
+      }
+
+      edges.push_back(Edge{ next, EdgeKind::Fallthrough });
+
+      if(isSkip(decoded.family) && contains(memory, next, 2)) {
+        const auto skipped = decode(memory, next, xoChip);
+        edges.push_back(Edge{ static_cast<Address>(next + skipped.length), EdgeKind::Branch });
+      }
+    }
+
+    struct Store {
+      Address block;
+      Address instruction;
+      std::size_t first;
+      std::size_t length;
+      bool resolved;
+    };
+
+  }
+
+  ControlFlowGraph buildControlFlowGraph(const Memory & memory, Address entry, bool xoChip) {
+    ControlFlowGraph graph;
+    graph.entry = entry;
+    graph.xoChip = xoChip;
+
+    // First find every reachable instruction and which of them start blocks.
+    std::map<Address, Decoded> instructions;
+    std::set<Address> leaders { entry };
+    std::deque<Address> pending { entry };
+    std::vector<Edge> edges;
+
+    while(!pending.empty()) {
+      const auto address = pending.front();
+      pending.pop_front();
+
+      if(instructions.count(address) || !contains(memory, address, 2)) {
+        continue;
+      }
+
+      auto decoded = decode(memory, address, xoChip);
+
+      if(!contains(memory, address, decoded.length)) {
+        decoded.family = OpcodeFamily::unknown;
+      }
+
+      instructions[address] = decoded;
+      edges.clear();
+      getSuccessors(memory, address, decoded, xoChip, edges);
+
+      for(const auto & edge : edges) {
+        if(edge.kind != EdgeKind::Fallthrough || endsBlock(decoded.family)) {
+          leaders.insert(edge.target);
+        }
+
+        if(edge.kind == EdgeKind::Call) {
+          graph.subroutines.insert(edge.target);
+        }
+
+        pending.push_back(edge.target);
+      }
+    }
+
+    // Then cut the instructions into blocks at the leaders.
+    std::vector<Store> stores;
+
+    for(const auto leader : leaders) {
+      if(!instructions.count(leader)) {
+        continue;
+      }
+
+      BasicBlock block{ leader, leader, 0, {}, false, false, false, false, false };
+      bool knowsI = false;
+      std::size_t I = 0;
+      Address address = leader;
+
+      for(;;) {
+        const auto & decoded = instructions[address];
+
+        block.instructionCount += 1;
+        block.end = address + decoded.length;
+
+        switch(decoded.family) {
+          case OpcodeFamily::setIToAddress:
+            knowsI = true;
+            I = getAddress(decoded.instruction);
+            break;
+
+          case OpcodeFamily::setIToLongAddress:
+            knowsI = true;
+            I = readInstruction(memory, address + 2);
+            break;
+
+          case OpcodeFamily::addVxToI:
+          case OpcodeFamily::setIToCharacter:
+          case OpcodeFamily::setIToBigCharacter:
+            knowsI = false;
+            break;
+
+          default:
+            break;
+        }
+
+        const auto storeLength = analysis::getStoreLength(decoded.family, decoded.instruction);
+
+        if(storeLength > 0) {
+          stores.push_back(Store{ leader, address, I, storeLength, knowsI });
+        }
+
+        if(endsBlock(decoded.family)) {
+          block.endsInReturn = decoded.family == OpcodeFamily::returnFromSubroutine;
+          block.endsInComputedJump = decoded.family == OpcodeFamily::jumpPlusV0;
+          block.endsInInvalid = decoded.family == OpcodeFamily::callProgramAtAddress || decoded.family == OpcodeFamily::unknown;
+
+          if(block.endsInComputedJump) {
+            graph.computedJumps.push_back(address);
+          }
+
+          getSuccessors(memory, address, decoded, xoChip, block.successors);
+          break;
+        }
+
+        const Address next = block.end;
+
+        if(leaders.count(next) || !instructions.count(next)) {
+          getSuccessors(memory, address, decoded, xoChip, block.successors);
+          break;
+        }
+
+        address = next;
+      }
+
+      graph.blocks[leader] = block;
+    }
+
+    // Stores are only judged once every instruction's bytes are known.
+    std::vector<bool> isCode(memory.size(), false);
+
+    for(const auto & instruction : instructions) {
+      for(std::size_t i = 0; i < instruction.second.length && instruction.first + i < memory.size(); i++) {
+        isCode[instruction.first + i] = true;
+      }
+    }
+
+    for(const auto & store : stores) {
+      auto & block = graph.blocks[store.block];
+
+      if(!store.resolved) {
+        block.hasUnresolvedStore = true;
+        graph.unresolvedStores.push_back(store.instruction);
+        continue;
+      }
+
+      for(std::size_t i = store.first; i < store.first + store.length && i < memory.size(); i++) {
+        if(isCode[i]) {
+          block.hasSelfModifyingStore = true;
+          graph.selfModifyingStores.push_back(store.instruction);
+          break;
+        }
+      }
+    }
+
+    std::sort(graph.unresolvedStores.begin(), graph.unresolvedStores.end());
+    graph.unresolvedStores.erase(std::unique(graph.unresolvedStores.begin(), graph.unresolvedStores.end()), graph.unresolvedStores.end());
+    std::sort(graph.selfModifyingStores.begin(), graph.selfModifyingStores.end());
+    graph.selfModifyingStores.erase(std::unique(graph.selfModifyingStores.begin(), graph.selfModifyingStores.end()), graph.selfModifyingStores.end());
+    std::sort(graph.computedJumps.begin(), graph.computedJumps.end());
+
+    return graph;
+  }
+
+  const char * getEdgeKindName(EdgeKind kind) {
+    switch(kind) {
+      case EdgeKind::Fallthrough: return "fallthrough";
+      case EdgeKind::Jump: return "jump";
+      case EdgeKind::Branch: return "branch";
+      case EdgeKind::Call: return "call";
+    }
+
+    return "unknown";
+  }
+
+  namespace {
+
+    void writeAddresses(std::ostream & out, const char * name, const std::vector<Address> & addresses) {
+      out << ",\n  \"" << name << "\": [";
+
+      for(std::size_t i = 0; i < addresses.size(); i++) {
+        out << (i == 0 ? "" : ", ") << addresses[i];
+      }
+
+      out << "]";
+    }
+
+  }
+
+  void writeDot(const ControlFlowGraph & graph, std::ostream & out) {
+    out << "digraph rom {\n"
+        << "  node [shape=box, fontname=monospace];\n";
+
+    for(const auto & entry : graph.blocks) {
+      const auto & block = entry.second;
+
+      out << "  \"" << analysis::hexAddress(block.start) << "\" [label=\"" << analysis::hexAddress(block.start)
+          << "-" << analysis::hexAddress(block.end - 1) << "\\n"
+          << block.instructionCount << (block.instructionCount == 1 ? " instruction" : " instructions");
+
+      if(graph.subroutines.count(block.start)) {
+        out << "\\nsubroutine";
+      }
+      if(block.endsInComputedJump) {
+        out << "\\ncomputed jump";
+      }
+      if(block.endsInInvalid) {
+        out << "\\ninvalid instruction";
+      }
+      if(block.hasSelfModifyingStore) {
+        out << "\\nself-modifying store";
+      }
+      if(block.hasUnresolvedStore) {
+        out << "\\nunresolved store";
+      }
+
+      out << "\"";
+
+      if(block.start == graph.entry) {
+        out << ", penwidth=2";
+      }
+      if(block.hasSelfModifyingStore || block.endsInComputedJump) {
+        out << ", color=red";
+      }
+
+      out << "];\n";
+    }
+
+    for(const auto & entry : graph.blocks) {
+      for(const auto & edge : entry.second.successors) {
+        out << "  \"" << analysis::hexAddress(entry.first) << "\" -> \"" << analysis::hexAddress(edge.target) << "\"";
+
+        switch(edge.kind) {
+          case EdgeKind::Call:
+            out << " [style=dashed]";
+            break;
+          case EdgeKind::Branch:
+            out << " [label=skip]";
+            break;
+          default:
+            break;
+        }
+
+        out << ";\n";
+      }
+    }
+
+    out << "}\n";
+  }
+
+  void writeJson(const ControlFlowGraph & graph, std::ostream & out) {
+    out << "{\n  \"entry\": " << graph.entry << ",\n  \"blocks\": [";
+
+    bool first = true;
+
+    for(const auto & entry : graph.blocks) {
+      const auto & block = entry.second;
+
+      out << (first ? "\n" : ",\n")
+          << "    { \"start\": " << block.start
+          << ", \"end\": " << block.end
+          << ", \"instructions\": " << block.instructionCount
+          << ", \"subroutine\": " << (graph.subroutines.count(block.start) ? "true" : "false")
+          << ", \"returns\": " << (block.endsInReturn ? "true" : "false")
+          << ", \"computed_jump\": " << (block.endsInComputedJump ? "true" : "false")
+          << ", \"invalid\": " << (block.endsInInvalid ? "true" : "false")
+          << ", \"self_modifying_store\": " << (block.hasSelfModifyingStore ? "true" : "false")
+          << ", \"unresolved_store\": " << (block.hasUnresolvedStore ? "true" : "false")
+          << ", \"successors\": [";
+
+      for(std::size_t i = 0; i < block.successors.size(); i++) {
+        out << (i == 0 ? "" : ", ")
+            << "{ \"target\": " << block.successors[i].target
+            << ", \"kind\": \"" << getEdgeKindName(block.successors[i].kind) << "\" }";
+      }
+
+      out << "] }";
+      first = false;
+    }
+
+    out << "\n  ]";
+
+    const std::vector<Address> subroutines(graph.subroutines.begin(), graph.subroutines.end());
+    writeAddresses(out, "subroutines", subroutines);
+    writeAddresses(out, "computed_jumps", graph.computedJumps);
+    writeAddresses(out, "self_modifying_stores", graph.selfModifyingStores);
+    writeAddresses(out, "unresolved_stores", graph.unresolvedStores);
+
+    out << "\n}\n";
+  }
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "chip8/Decoder.hpp"
+
+namespace chip8 {
+
+  // The syntax follows Cowgod's CHIP-8 reference, with the SUPER-CHIP and
+  // XO-CHIP additions written the same way.
+  constexpr OpcodeInfo OPCODE_INFO[OPCODE_FAMILY_COUNT] {
+    { "clearScreen",                 0xFFFF, 0x00E0, "CLS" },
+    { "returnFromSubroutine",        0xFFFF, 0x00EE, "RET" },
+    { "callProgramAtAddress",        0xF000, 0x0000, "SYS %a" },
+    { "scrollDown",                  0xFFF0, 0x00C0, "SCD %n" },
+    { "scrollUp",                    0xFFF0, 0x00D0, "SCU %n" },
+    { "scrollRight",                 0xFFFF, 0x00FB, "SCR" },
+    { "scrollLeft",                  0xFFFF, 0x00FC, "SCL" },
+    { "disableHighResolution",       0xFFFF, 0x00FE, "LOW" },
+    { "enableHighResolution",        0xFFFF, 0x00FF, "HIGH" },
+    { "jump",                        0xF000, 0x1000, "JP %a" },
+    { "callSubroutine",              0xF000, 0x2000, "CALL %a" },
+    { "skipIfEquals",                0xF000, 0x3000, "SE V%x, %b" },
+    { "skipIfNotEquals",             0xF000, 0x4000, "SNE V%x, %b" },
+    { "skipIfVxEqualsVy",            0xF000, 0x5000, "SE V%x, V%y" },
+    { "storeVxToVy",                 0xF00F, 0x5002, "SAVE V%x, V%y" },
+    { "loadVxToVy",                  0xF00F, 0x5003, "LOAD V%x, V%y" },
+    { "setVx",                       0xF000, 0x6000, "LD V%x, %b" },
+    { "addToVx",                     0xF000, 0x7000, "ADD V%x, %b" },
+    { "setVxToVy",                   0xF00F, 0x8000, "LD V%x, V%y" },
+    { "orVxVy",                      0xF00F, 0x8001, "OR V%x, V%y" },
+    { "andVxVy",                     0xF00F, 0x8002, "AND V%x, V%y" },
+    { "xorVxVy",                     0xF00F, 0x8003, "XOR V%x, V%y" },
+    { "addVxVyUpdateCarry",          0xF00F, 0x8004, "ADD V%x, V%y" },
+    { "subtractVxVyUpdateCarry",     0xF00F, 0x8005, "SUB V%x, V%y" },
+    { "rightshiftVx",                0xF00F, 0x8006, "SHR V%x, V%y" },
+    { "subtractVxFromVyUpdateCarry", 0xF00F, 0x8007, "SUBN V%x, V%y" },
+    { "leftshiftVx",                 0xF00F, 0x800E, "SHL V%x, V%y" },
+    { "skipIfVxNotEqualsVy",         0xF000, 0x9000, "SNE V%x, V%y" },
+    { "setIToAddress",               0xF000, 0xA000, "LD I, %a" },
+    { "jumpPlusV0",                  0xF000, 0xB000, "JP V0, %a" },
+    { "randomVxModNn",               0xF000, 0xC000, "RND V%x, %b" },
+    { "blit",                        0xF000, 0xD000, "DRW V%x, V%y, %n" },
+    { "skipIfKeyIsPressed",          0xF0FF, 0xE09E, "SKP V%x" },
+    { "skipIfKeyIsNotPressed",       0xF0FF, 0xE0A1, "SKNP V%x" },
+    { "setIToLongAddress",           0xFFFF, 0xF000, "LD I, LONG %l" },
+    { "selectPlanes",                0xF0FF, 0xF001, "PLANE %k" },
+    { "loadAudioPattern",            0xFFFF, 0xF002, "AUDIO" },
+    { "setVxToDelayTimer",           0xF0FF, 0xF007, "LD V%x, DT" },
+    { "waitForKeyPress",             0xF0FF, 0xF00A, "LD V%x, K" },
+    { "setDelayTimer",               0xF0FF, 0xF015, "LD DT, V%x" },
+    { "setSoundTimer",               0xF0FF, 0xF018, "LD ST, V%x" },
+    { "setPitch",                    0xF0FF, 0xF03A, "PITCH V%x" },
+    { "addVxToI",                    0xF0FF, 0xF01E, "ADD I, V%x" },
+    { "setIToCharacter",             0xF0FF, 0xF029, "LD F, V%x" },
+    { "setIToBigCharacter",          0xF0FF, 0xF030, "LD HF, V%x" },
+    { "storeBcdOfVx",                0xF0FF, 0xF033, "LD B, V%x" },
+    { "storeV0ToVx",                 0xF0FF, 0xF055, "LD [I], V%x" },
+    { "loadV0ToVx",                  0xF0FF, 0xF065, "LD V%x, [I]" },
+    { "unknown",                     0x0000, 0x0000, "DW %w" }
+  };
+
+  namespace {
+
+    constexpr std::size_t UNKNOWN = OPCODE_FAMILY_COUNT - 1;
+
+    constexpr unsigned int countBits(unsigned int bits) {
+      return bits == 0 ? 0 : (bits & 1) + countBits(bits >> 1);
+    }
+
+    constexpr bool isNarrower(std::size_t family, std::size_t than) {
+      return than == UNKNOWN || countBits(OPCODE_INFO[family].mask) > countBits(OPCODE_INFO[than].mask);
+    }
+
+    // The family with the narrowest pattern (the most bits in its mask)
+    // that matches, so 5XY2 wins over 5XYN and 00E0 over 0NNN. C++11
+    // constexpr functions can't loop, hence the recursion.
+    constexpr std::size_t findFamily(Instruction instruction, std::size_t family = 0, std::size_t best = UNKNOWN) {
+      return family == UNKNOWN
+        ? best
+        : findFamily(instruction, family + 1,
+            (instruction & OPCODE_INFO[family].mask) == OPCODE_INFO[family].value && isNarrower(family, best) ? family : best);
+    }
+
+    template <std::size_t... Indices>
+    struct IndexList {};
+
+    template <std::size_t Count, std::size_t... Indices>
+    struct MakeIndexList : MakeIndexList<Count - 1, Count - 1, Indices...> {};
+
+    template <std::size_t... Indices>
+    struct MakeIndexList<0, Indices...> {
+      using type = IndexList<Indices...>;
+    };
+
+    template <std::size_t... LowBytes>
+    constexpr std::array<std::uint8_t, 0x100> findGroupFamilies(Instruction group, IndexList<LowBytes...>) {
+      return { { static_cast<std::uint8_t>(findFamily(static_cast<Instruction>(group | LowBytes)))... } };
+    }
+
+    template <std::size_t... Groups>
+    constexpr std::array<std::array<std::uint8_t, 0x100>, 0x10> findAllFamilies(IndexList<Groups...>) {
+      return { { findGroupFamilies(static_cast<Instruction>(Groups << 12), MakeIndexList<0x100>::type{})... } };
+    }
+
+  }
+
+  constexpr std::array<std::array<std::uint8_t, 0x100>, 0x10> OPCODE_FAMILIES = findAllFamilies(MakeIndexList<0x10>::type{});
+}
\ No newline at end of file
@@ -0,0 +1,232 @@
+#include "chip8/Disassembler.hpp"
+#include "chip8/Decoder.hpp"
+#include "chip8/Functions.hpp"
+
+namespace chip8 {
+
+  namespace {
+
+    const char HEX_DIGITS[] = "0123456789ABCDEF";
+
+    char * writeHexDigits(char * out, unsigned int value, int digits) {
+      for(int shift = (digits - 1) * 4; shift >= 0; shift -= 4) {
+        *out++ = HEX_DIGITS[(value >> shift) & 0xF];
+      }
+
+      return out;
+    }
+
+    char * writeHex(char * out, unsigned int value, int digits) {
+      *out++ = '0';
+      *out++ = 'x';
+      return writeHexDigits(out, value, digits);
+    }
+
+    // Nibbles only, so at most two digits.
+    char * writeDecimal(char * out, unsigned int value) {
+      if(value >= 10) {
+        *out++ = static_cast<char>('0' + value / 10);
+      }
+
+      *out++ = static_cast<char>('0' + value % 10);
+      return out;
+    }
+
+    char * writeText(char * out, const char * text) {
+      while(*text) {
+        *out++ = *text++;
+      }
+
+      return out;
+    }
+
+    // Whether assembling the instruction's text gives the instruction back:
+    // every bit outside its family's mask is one an operand writes.
+    bool isCanonical(Instruction instruction) {
+      const auto & info = getOpcodeInfo(classify(instruction));
+      unsigned int operandBits = 0;
+
+      for(const char * syntax = info.syntax; *syntax; syntax++) {
+        if(*syntax != '%') {
+          continue;
+        }
+
+        switch(*++syntax) {
+          case 'x':
+          case 'k':
+            operandBits |= 0x0F00;
+            break;
+          case 'y':
+            operandBits |= 0x00F0;
+            break;
+          case 'n':
+            operandBits |= 0x000F;
+            break;
+          case 'b':
+            operandBits |= 0x00FF;
+            break;
+          case 'a':
+            operandBits |= 0x0FFF;
+            break;
+          case 'w':
+            operandBits |= 0xFFFF;
+            break;
+        }
+      }
+
+      return (instruction & ~(info.mask | operandBits) & 0xFFFF) == 0;
+    }
+
+    char * writeSpaces(char * out, std::size_t count) {
+      for(std::size_t i = 0; i < count; i++) {
+        *out++ = ' ';
+      }
+
+      return out;
+    }
+
+  }
+
+  std::size_t disassemble(Instruction instruction, Instruction longAddress, char * out) {
+    const auto & info = getOpcodeInfo(classify(instruction));
+    const auto start = out;
+
+    for(const char * syntax = info.syntax; *syntax; syntax++) {
+      if(*syntax != '%') {
+        *out++ = *syntax;
+        continue;
+      }
+
+      switch(*++syntax) {
+        case 'x':
+          out = writeHexDigits(out, (instruction >> 8) & 0xF, 1);
+          break;
+        case 'y':
+          out = writeHexDigits(out, (instruction >> 4) & 0xF, 1);
+          break;
+        case 'k':
+          out = writeDecimal(out, (instruction >> 8) & 0xF);
+          break;
+        case 'n':
+          out = writeDecimal(out, instruction & 0xF);
+          break;
+        case 'b':
+          out = writeHex(out, getLowByte(instruction), 2);
+          break;
+        case 'a':
+          out = writeHex(out, getAddress(instruction), 3);
+          break;
+        case 'l':
+          out = writeHex(out, longAddress, 4);
+          break;
+        case 'w':
+          out = writeHex(out, instruction, 4);
+          break;
+      }
+    }
+
+    return out - start;
+  }
+
+  Disassembly disassemble(Instruction instruction, Instruction longAddress) {
+    Disassembly disassembly;
+    disassembly.length = disassemble(instruction, longAddress, disassembly.text.data());
+    disassembly.text[disassembly.length] = '\0';
+    return disassembly;
+  }
+
+  void disassemble(const Byte * data, std::size_t size, Address origin, std::string & out) {
+    const int addressDigits = origin + size > 0x1000 ? 4 : 3;
+    const auto lines = size / 2 + 1;
+    const auto start = out.size();
+
+    // Sized for the longest lines, then trimmed to what was written.
+    out.resize(start + lines * LISTING_LINE_MAX_LENGTH);
+
+    char * const begin = &out[start];
+    char * line = begin;
+    std::size_t offset = 0;
+
+    while(offset < size) {
+      line = writeHex(line, origin + offset, addressDigits);
+      line = writeSpaces(line, 2);
+
+      if(offset + 1 == size) {
+        line = writeHexDigits(line, data[offset], 2);
+        line = writeSpaces(line, 9);
+        line = writeText(line, "DB ");
+        line = writeHex(line, data[offset], 2);
+        *line++ = '\n';
+        offset += 1;
+        continue;
+      }
+
+      const auto instruction = static_cast<Instruction>((data[offset] << 8) | data[offset + 1]);
+      Instruction longAddress = 0;
+      std::size_t length = 2;
+
+      line = writeHexDigits(line, instruction, 4);
+
+      if(classify(instruction) == OpcodeFamily::setIToLongAddress && offset + 4 <= size) {
+        longAddress = static_cast<Instruction>((data[offset + 2] << 8) | data[offset + 3]);
+        length = 4;
+
+        *line++ = ' ';
+        line = writeHexDigits(line, longAddress, 4);
+        line = writeSpaces(line, 2);
+      } else {
+        line = writeSpaces(line, 7);
+      }
+
+      line += disassemble(instruction, longAddress, line);
+      *line++ = '\n';
+      offset += length;
+    }
+
+    out.resize(start + (line - begin));
+  }
+
+  void disassembleSource(const Byte * data, std::size_t size, Address origin, std::string & out) {
+    const auto lines = size / 2 + 2;
+    const auto start = out.size();
+
+    out.resize(start + lines * (DISASSEMBLY_MAX_LENGTH + 1));
+
+    char * const begin = &out[start];
+    char * line = begin;
+    std::size_t offset = 0;
+
+    line = writeText(line, "ORG ");
+    line = writeHex(line, origin, origin >= 0x1000 ? 4 : 3);
+    *line++ = '\n';
+
+    while(offset < size) {
+      if(offset + 1 == size) {
+        line = writeText(line, "DB ");
+        line = writeHex(line, data[offset], 2);
+        *line++ = '\n';
+        offset += 1;
+        continue;
+      }
+
+      const auto instruction = static_cast<Instruction>((data[offset] << 8) | data[offset + 1]);
+      const bool isLong = classify(instruction) == OpcodeFamily::setIToLongAddress;
+
+      if(!isCanonical(instruction) || (isLong && offset + 4 > size)) {
+        line = writeText(line, "DW ");
+        line = writeHex(line, instruction, 4);
+        offset += 2;
+      } else if(isLong) {
+        line += disassemble(instruction, static_cast<Instruction>((data[offset + 2] << 8) | data[offset + 3]), line);
+        offset += 4;
+      } else {
+        line += disassemble(instruction, 0, line);
+        offset += 2;
+      }
+
+      *line++ = '\n';
+    }
+
+    out.resize(start + (line - begin));
+  }
+}
\ No newline at end of file
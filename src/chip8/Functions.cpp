@@ -1,38 +1,89 @@
 #include "chip8/Functions.hpp"
+#include "chip8/Decoder.hpp"
 #include "chip8/VirtualMachine.hpp"
 #include "chip8/Opcodes.hpp"
 #include <algorithm>
 #include <array>
 #include <bitset>
-#include <functional>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <iterator>
 
 namespace chip8 {
 
-  std::array<std::function<void(VirtualMachine &, Instruction)>, 16> FUNCTION_TABLE { {
-    ops::disambiguate0x0,     // 0x0000
-    ops::jump,                // 0x1000
-    ops::callSubroutine,      // 0x2000
-    ops::skipIfEquals,        // 0x3000
-    ops::skipIfNotEquals,     // 0x4000
-    ops::skipIfVxEqualsVy,    // 0x5000
-    ops::setVx,               // 0x6000
-    ops::addToVx,             // 0x7000
-    ops::disambiguate0x8,     // 0x8000
-    ops::skipIfVxNotEqualsVy, // 0x9000
-    ops::setIToAddress,       // 0xA000
-    ops::jumpPlusV0,          // 0xB000
-    ops::randomVxModNn,       // 0xC000
-    ops::blit,                // 0xD000
-    ops::disambiguate0xE,     // 0xE000
-    ops::disambiguate0xF      // 0xF000
+  // Constant-initialised from the font macros, so it sits in read-only data
+  // with nothing to run at startup.
+  alignas(64) const ByteArray<RAM_SIZE> INITIAL_MEMORY { {
+    CHIP8_FONT_BYTES,
+    CHIP8_BIG_FONT_BYTES
+  } };
+
+  namespace {
+    // Instructions no handler accepts do nothing, as they always have.
+    void ignoreInstruction(VirtualMachine & vm, Instruction instruction) {
+
+    }
+  }
+
+  // In OpcodeFamily order; execute() picks the handler for the family
+  // classify() decodes, so a couple of table lookups replace the top nibble
+  // dispatch and the disambiguate switches.
+  const std::array<void (*)(VirtualMachine &, Instruction), OPCODE_FAMILY_COUNT> OPCODE_HANDLERS { {
+    ops::clearScreen,
+    ops::returnFromSubroutine,
+    ops::callProgramAtAddress,
+    ops::scrollDown,
+    ops::scrollUp,
+    ops::scrollRight,
+    ops::scrollLeft,
+    ops::disableHighResolution,
+    ops::enableHighResolution,
+    ops::jump,
+    ops::callSubroutine,
+    ops::skipIfEquals,
+    ops::skipIfNotEquals,
+    ops::skipIfVxEqualsVy,
+    ops::storeVxToVy,
+    ops::loadVxToVy,
+    ops::setVx,
+    ops::addToVx,
+    ops::setVxToVy,
+    ops::orVxVy,
+    ops::andVxVy,
+    ops::xorVxVy,
+    ops::addVxVyUpdateCarry,
+    ops::subtractVxVyUpdateCarry,
+    ops::rightshiftVx,
+    ops::subtractVxFromVyUpdateCarry,
+    ops::leftshiftVx,
+    ops::skipIfVxNotEqualsVy,
+    ops::setIToAddress,
+    ops::jumpPlusV0,
+    ops::randomVxModNn,
+    ops::blit,
+    ops::skipIfKeyIsPressed,
+    ops::skipIfKeyIsNotPressed,
+    ops::setIToLongAddress,
+    ops::selectPlanes,
+    ops::loadAudioPattern,
+    ops::setVxToDelayTimer,
+    ops::waitForKeyPress,
+    ops::setDelayTimer,
+    ops::setSoundTimer,
+    ops::setPitch,
+    ops::addVxToI,
+    ops::setIToCharacter,
+    ops::setIToBigCharacter,
+    ops::storeBcdOfVx,
+    ops::storeV0ToVx,
+    ops::loadV0ToVx,
+    ignoreInstruction
   } };
 
   Instruction fetch(VirtualMachine & vm) {
-    Instruction highByte = static_cast<Instruction>(vm.memory[vm.programCounter]) << 8;
-    Instruction lowByte = static_cast<Instruction>(vm.memory[vm.programCounter + 1]);
+    Instruction highByte = static_cast<Instruction>(vm.memory[wrapAddress(vm.memory, vm.programCounter)]) << 8;
+    Instruction lowByte = static_cast<Instruction>(vm.memory[wrapAddress(vm.memory, vm.programCounter + 1)]);
 
     vm.programCounter += 2;
 
@@ -40,11 +91,7 @@ namespace chip8 {
   }
 
   void execute(VirtualMachine & vm, Instruction instruction) {
-    // no-op
-    const Instruction OP_MASK = 0xF000;
-    const auto handlerOffset = (instruction & OP_MASK) >> 12;
-
-    FUNCTION_TABLE[handlerOffset](vm, instruction);
+    OPCODE_HANDLERS[static_cast<std::size_t>(classify(instruction))](vm, instruction);
   }
 
   void cycle(VirtualMachine & vm) {
@@ -58,6 +105,26 @@ namespace chip8 {
     vm.programCounter = PROGRAM_START_ADDRESS;
   }
 
+  void updateTimers(VirtualMachine & vm) {
+    if(vm.timers.delay > 0) {
+      vm.timers.delay -= 1;
+    }
+
+    if(vm.timers.sound > 0) {
+      vm.timers.sound -= 1;
+    }
+  }
+
+  void enableXoChip(VirtualMachine & vm) {
+    vm.xoChip = true;
+
+    if(!vm.xoChipRam) {
+      vm.xoChipRam.reset(new ByteArray<XO_CHIP_RAM_SIZE>());
+      std::memcpy(vm.xoChipRam->data(), vm.ram.data(), vm.ram.size());
+      vm.attachMemory();
+    }
+  }
+
   void handleKeypress(VirtualMachine & vm, Byte key) {
     if(vm.awaitingKeypress) {
       vm.awaitingKeypress = false;
@@ -72,36 +139,95 @@ namespace chip8 {
   }
 
   void printGraphicsBufferToConsole(VirtualMachine & vm) {
-    const auto & graphics = vm.graphics;
-    const auto rows = graphics.size();
+    if(vm.highResolution) {
+      for(const auto & row : vm.hiResGraphics) {
+        std::cout << std::bitset<64>{row[0]} << std::bitset<64>{row[1]} << "\n";
+      }
+    } else {
+      const auto & graphics = vm.graphics;
+      const auto rows = graphics.size();
 
-    for(std::size_t y = 0; y < rows; y++) {
-      const auto pixels = graphics[y];
-      std::cout << std::setfill('0') << std::bitset<64>{pixels} << "\n";
+      for(std::size_t y = 0; y < rows; y++) {
+        const auto pixels = graphics[y];
+        std::cout << std::setfill('0') << std::bitset<64>{pixels} << "\n";
+      }
     }
 
     std::cout << "\n" << std::endl;
   }
 
-  void loadRomData(VirtualMachine & vm, const std::vector<char> & data) {
-    std::transform(
-      std::begin(data),
-      std::end(data),
-      std::begin(vm.memory) + PROGRAM_START_ADDRESS,
-      [](const char c) {
-        return static_cast<Byte>(c);
-      }
-    );
+  const char * describe(LoadStatus status) {
+    switch(status) {
+      case LoadStatus::Loaded:
+        return "loaded";
+      case LoadStatus::CannotOpen:
+        return "the file cannot be opened";
+      case LoadStatus::CannotRead:
+        return "the file cannot be read";
+      case LoadStatus::Empty:
+        return "the rom is empty";
+      case LoadStatus::TooLarge:
+        return "the rom is too large for the VM's memory";
+    }
+
+    return "unknown load status";
+  }
+
+  LoadStatus checkRomSize(const VirtualMachine & vm, std::size_t size) {
+    if(size == 0) {
+      return LoadStatus::Empty;
+    }
+
+    if(size > vm.memory.size() - PROGRAM_START_ADDRESS) {
+      return LoadStatus::TooLarge;
+    }
+
+    return LoadStatus::Loaded;
+  }
+
+  LoadStatus loadRomData(VirtualMachine & vm, const char * data, std::size_t size) {
+    const auto status = checkRomSize(vm, size);
+
+    if(status == LoadStatus::Loaded) {
+      std::memcpy(&vm.memory[PROGRAM_START_ADDRESS], data, size);
+    }
+
+    return status;
+  }
+
+  LoadStatus loadRomData(VirtualMachine & vm, const std::vector<char> & data) {
+    return loadRomData(vm, data.data(), data.size());
+  }
+
+  Memory buildMemoryImage(const char * rom, std::size_t size) {
+    Memory image(PROGRAM_START_ADDRESS + size, 0);
+
+    std::memcpy(image.data(), INITIAL_MEMORY.data(), PROGRAM_START_ADDRESS);
+    std::memcpy(&image[PROGRAM_START_ADDRESS], rom, size);
+
+    return image;
+  }
+
+  LoadStatus loadMemoryImage(VirtualMachine & vm, const Memory & image) {
+    if(image.size() <= PROGRAM_START_ADDRESS) {
+      return LoadStatus::Empty;
+    }
+
+    if(image.size() > vm.memory.size()) {
+      return LoadStatus::TooLarge;
+    }
+
+    std::memcpy(vm.memory.data(), image.data(), image.size());
+    std::memset(vm.memory.data() + image.size(), 0, vm.memory.size() - image.size());
+
+    return LoadStatus::Loaded;
+  }
+
+  void loadFontData(VirtualMachine & vm, const Byte * data, std::size_t size) {
+    std::memcpy(&vm.memory[FONT_ADDRESS], data, size);
   }
 
   void loadFontData(VirtualMachine & vm, const std::vector<Byte> & data) {
-    std::transform(
-      std::begin(data),
-      std::end(data),
-      std::begin(vm.memory), // Load the font dats at the beginning of memory.
-      [](const char c) {
-        return static_cast<Byte>(c);
-      }
-    );
+    loadFontData(vm, data.data(), data.size());
   }
 }
\ No newline at end of file
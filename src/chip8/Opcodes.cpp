@@ -1,18 +1,179 @@
 #include "chip8/Opcodes.hpp"
 #include "chip8/Functions.hpp"
+#include "chip8/Scrolling.hpp"
 #include "chip8/VirtualMachine.hpp"
+#include <algorithm>
 #include <exception>
 #include <bitset>
 #include <iomanip>
 #include <iostream>
+#include <utility>
 
 namespace chip8 {
+  namespace {
+    // XO-CHIP's F000 NNNN is four bytes long, so a skip has to step over all
+    // of it. Only checked in XO-CHIP mode, where that instruction exists.
+    inline void skipNextInstruction(VirtualMachine & vm) {
+      if(vm.xoChip && vm.memory[wrapAddress(vm.memory, vm.programCounter)] == 0xF0 && vm.memory[wrapAddress(vm.memory, vm.programCounter + 1)] == 0x00) {
+        vm.programCounter += 4;
+      } else {
+        vm.programCounter += 2;
+      }
+    }
+
+    // Runs operation on each bit plane selected with FN01, using the buffers
+    // of the current resolution. Unless a rom selects otherwise that is just
+    // plane 1, the buffer CHIP-8 and SUPER-CHIP roms draw to.
+    template <typename Operation>
+    void forEachSelectedPlane(VirtualMachine & vm, Operation operation) {
+      if(vm.highResolution) {
+        if(vm.selectedPlanes & 0x1) {
+          operation(vm.hiResGraphics);
+        }
+
+        if(vm.selectedPlanes & 0x2) {
+          operation(vm.hiResGraphicsPlane2);
+        }
+      } else {
+        if(vm.selectedPlanes & 0x1) {
+          operation(vm.graphics);
+        }
+
+        if(vm.selectedPlanes & 0x2) {
+          operation(vm.graphicsPlane2);
+        }
+      }
+    }
+
+    struct ClearPlane {
+      template <typename Buffer>
+      void operator()(Buffer & plane) const {
+        plane.fill(typename Buffer::value_type{});
+      }
+    };
+
+    struct ScrollPlaneDown {
+      std::size_t rows;
+
+      template <typename Buffer>
+      void operator()(Buffer & plane) const {
+        scrollPlaneDown(plane, rows);
+      }
+    };
+
+    struct ScrollPlaneUp {
+      std::size_t rows;
+
+      template <typename Buffer>
+      void operator()(Buffer & plane) const {
+        scrollPlaneUp(plane, rows);
+      }
+    };
+
+    struct ScrollPlaneRight {
+      template <typename Buffer>
+      void operator()(Buffer & plane) const {
+        scrollPlaneRight(plane, 4);
+      }
+    };
+
+    struct ScrollPlaneLeft {
+      template <typename Buffer>
+      void operator()(Buffer & plane) const {
+        scrollPlaneLeft(plane, 4);
+      }
+    };
+
+    // Draws rows of 8 pixel wide sprite data from memory at pointer into a
+    // low resolution plane, returning whether any pixel was turned off.
+    bool blitPlane(GraphicsBuffer & plane, const MemoryView & memory, Address pointer, Byte startX, Byte startY, std::size_t rows) {
+      const std::uint64_t rowProjection = 0b0000000000000000000000000000000000000000000000000000000000000000;
+      bool collision = false;
+
+      // Loop over sprite rows that need to be rendered.
+      for(std::size_t i = 0; i < rows; i++) {
+        const auto spriteRow = memory[wrapAddress(memory, pointer + i)];
+        auto offsetX = startX;
+        auto offsetY = (startY + i) % DISPLAY_HEIGHT;
+        auto shift = ((sizeof(rowProjection) - sizeof(spriteRow)) * 8) % 64;
+
+        // Calculate a shift to the left enough to move the sprite all the way
+        // to the left-most position, like a typewriter moving to a new line.
+        // Then we rotate right to allow for horizontal positioning and wrapping.
+        const auto spriteProjection = rotateRight((rowProjection | spriteRow) << shift, offsetX);
+
+        plane[offsetY] ^= spriteProjection;
+
+        const auto diff = ~plane[offsetY] & spriteProjection;
+
+        collision = collision || diff != 0;
+      }
+
+      return collision;
+    }
+
+    // The high resolution version also draws 16x16 sprites (two bytes per
+    // row), and works on both words of a row at once.
+    bool blitPlane(HiResGraphicsBuffer & plane, const MemoryView & memory, Address pointer, Byte startX, Byte startY, std::size_t rows, bool isLargeSprite) {
+      const std::size_t offsetX = startX % HI_RES_DISPLAY_WIDTH;
+      const std::size_t wordShift = offsetX % 64;
+      bool collision = false;
+
+      for(std::size_t i = 0; i < rows; i++) {
+        std::uint64_t left;
+        std::uint64_t right = 0;
+
+        if(isLargeSprite) {
+          const auto address = pointer + i * 2;
+          left = (static_cast<std::uint64_t>(memory[wrapAddress(memory, address)]) << 56) | (static_cast<std::uint64_t>(memory[wrapAddress(memory, address + 1)]) << 48);
+        } else {
+          left = static_cast<std::uint64_t>(memory[wrapAddress(memory, pointer + i)]) << 56;
+        }
+
+        // The sprite starts at the left edge of the 128 pixel row; rotate it
+        // right across both words into position, wrapping like low resolution.
+        if(offsetX >= 64) {
+          std::swap(left, right);
+        }
+
+        if(wordShift != 0) {
+          const auto shiftedLeft = (left >> wordShift) | (right << (64 - wordShift));
+          const auto shiftedRight = (right >> wordShift) | (left << (64 - wordShift));
+
+          left = shiftedLeft;
+          right = shiftedRight;
+        }
+
+        auto & row = plane[(startY + i) % HI_RES_DISPLAY_HEIGHT];
+
+        collision = collision || ((row[0] & left) | (row[1] & right)) != 0;
+
+        row[0] ^= left;
+        row[1] ^= right;
+      }
+
+      return collision;
+    }
+  }
+
   namespace ops {
     void disambiguate0x0(VirtualMachine & vm, Instruction instruction) {
       if(0x00E0 == instruction) {
         clearScreen(vm, instruction);
       } else if(0x00EE == instruction) {
         returnFromSubroutine(vm, instruction);
+      } else if(0x00C0 == (instruction & 0xFFF0)) {
+        scrollDown(vm, instruction);
+      } else if(0x00D0 == (instruction & 0xFFF0)) {
+        scrollUp(vm, instruction);
+      } else if(0x00FB == instruction) {
+        scrollRight(vm, instruction);
+      } else if(0x00FC == instruction) {
+        scrollLeft(vm, instruction);
+      } else if(0x00FE == instruction) {
+        disableHighResolution(vm, instruction);
+      } else if(0x00FF == instruction) {
+        enableHighResolution(vm, instruction);
       } else {
         callProgramAtAddress(vm, instruction);
       }
@@ -23,7 +184,7 @@ namespace chip8 {
     }
 
     void clearScreen(VirtualMachine & vm, Instruction instruction) {
-      vm.graphics.fill(0);
+      forEachSelectedPlane(vm, ClearPlane{});
       vm.graphicsAreDirty = true;
     }
 
@@ -41,7 +202,50 @@ namespace chip8 {
       throw std::runtime_error("Function not implemented");
     }
 
+    // Scrolls move whole rows or shift whole words (see Scrolling.hpp), never
+    // individual pixels. In low resolution they scroll by low resolution
+    // pixels.
+    void scrollDown(VirtualMachine & vm, Instruction instruction) {
+      forEachSelectedPlane(vm, ScrollPlaneDown{ static_cast<std::size_t>(instruction & 0x000F) });
+      vm.graphicsAreDirty = true;
+    }
+
+    // 00DN is XO-CHIP's counterpart to SUPER-CHIP's 00CN.
+    void scrollUp(VirtualMachine & vm, Instruction instruction) {
+      forEachSelectedPlane(vm, ScrollPlaneUp{ static_cast<std::size_t>(instruction & 0x000F) });
+      vm.graphicsAreDirty = true;
+    }
+
+    void scrollRight(VirtualMachine & vm, Instruction instruction) {
+      forEachSelectedPlane(vm, ScrollPlaneRight{});
+      vm.graphicsAreDirty = true;
+    }
+
+    void scrollLeft(VirtualMachine & vm, Instruction instruction) {
+      forEachSelectedPlane(vm, ScrollPlaneLeft{});
+      vm.graphicsAreDirty = true;
+    }
+
+    // Switching resolution clears every plane, whichever are selected.
+    void disableHighResolution(VirtualMachine & vm, Instruction instruction) {
+      vm.highResolution = false;
+      ClearPlane{}(vm.graphics);
+      ClearPlane{}(vm.graphicsPlane2);
+      vm.graphicsAreDirty = true;
+    }
+
+    void enableHighResolution(VirtualMachine & vm, Instruction instruction) {
+      vm.highResolution = true;
+      ClearPlane{}(vm.hiResGraphics);
+      ClearPlane{}(vm.hiResGraphicsPlane2);
+      vm.graphicsAreDirty = true;
+    }
+
     void callSubroutine(VirtualMachine & vm, Instruction instruction) {
+      if(vm.stack.full()) {
+        throw std::runtime_error("Cannot call subroutine since stack is full");
+      }
+
       vm.stack.push(vm.programCounter);
       vm.programCounter = getAddress(instruction);
     }
@@ -55,7 +259,7 @@ namespace chip8 {
       auto value = vm.registers[x];
 
       if(value == nn) {
-        vm.programCounter += 2;
+        skipNextInstruction(vm);
       }
     }
 
@@ -68,7 +272,25 @@ namespace chip8 {
       auto value = vm.registers[x];
 
       if(value != nn) {
-        vm.programCounter += 2;
+        skipNextInstruction(vm);
+      }
+    }
+
+    void disambiguate0x5(VirtualMachine & vm, Instruction instruction) {
+      const Instruction LAST_NIBBLE_MASK = 0x000F;
+
+      switch(instruction & LAST_NIBBLE_MASK) {
+        case 0x2:
+          storeVxToVy(vm, instruction);
+          break;
+
+        case 0x3:
+          loadVxToVy(vm, instruction);
+          break;
+
+        default:
+          skipIfVxEqualsVy(vm, instruction);
+          break;
       }
     }
 
@@ -81,7 +303,41 @@ namespace chip8 {
       auto registerY = vm.registers[y];
 
       if(registerX == registerY) {
-        vm.programCounter += 2;
+        skipNextInstruction(vm);
+      }
+    }
+
+    void storeVxToVy(VirtualMachine & vm, Instruction instruction) {
+      Byte x, y;
+
+      std::tie(x, y) = getXY(instruction);
+
+      // The range includes both ends and runs backwards when X > Y; I is
+      // left unchanged.
+      const int step = x <= y ? 1 : -1;
+
+      for(int i = 0, registerIndex = x; ; i++, registerIndex += step) {
+        vm.memory[wrapAddress(vm.memory, vm.I + i)] = vm.registers[registerIndex];
+
+        if(registerIndex == y) {
+          break;
+        }
+      }
+    }
+
+    void loadVxToVy(VirtualMachine & vm, Instruction instruction) {
+      Byte x, y;
+
+      std::tie(x, y) = getXY(instruction);
+
+      const int step = x <= y ? 1 : -1;
+
+      for(int i = 0, registerIndex = x; ; i++, registerIndex += step) {
+        vm.registers[registerIndex] = vm.memory[wrapAddress(vm.memory, vm.I + i)];
+
+        if(registerIndex == y) {
+          break;
+        }
       }
     }
 
@@ -300,7 +556,7 @@ namespace chip8 {
       auto registerY = vm.registers[y];
 
       if(registerX != registerY) {
-        vm.programCounter += 2;
+        skipNextInstruction(vm);
       }
     }
 
@@ -328,38 +584,59 @@ namespace chip8 {
     }
 
     void blit(VirtualMachine & vm, Instruction instruction) {
+      if(vm.highResolution) {
+        blitHighResolution(vm, instruction);
+        return;
+      }
+
       Nibble x, y, n;
       Address pointer = vm.I;
+      bool collision = false;
 
       std::tie(x, y, n) = getXYN(instruction);
 
       const auto startX = vm.registers[x];
       const auto startY = vm.registers[y];
-      const std::uint64_t rowProjection = 0b0000000000000000000000000000000000000000000000000000000000000000;
 
-      // Loop over sprite rows that need to be rendered.
-      for(std::size_t i = 0; i < n; i++) {
-        const auto spriteRow = vm.memory[pointer + i];
-        auto offsetX = startX;
-        auto offsetY = (startY + i) % 32;
-        auto shift = ((sizeof(rowProjection) - sizeof(spriteRow)) * 8) % 64;
+      // With both XO-CHIP planes selected, plane 2's sprite follows plane 1's.
+      if(vm.selectedPlanes & 0x1) {
+        collision = blitPlane(vm.graphics, vm.memory, pointer, startX, startY, n);
+        pointer += n;
+      }
 
-        // Calculate a shift to the left enough to move the sprite all the way
-        // to the left-most position, like a typewriter moving to a new line.
-        // Then we rotate right to allow for horizontal positioning and wrapping.
-        const auto spriteProjection = rotateRight((rowProjection | spriteRow) << shift, offsetX);
+      if(vm.selectedPlanes & 0x2) {
+        collision = blitPlane(vm.graphicsPlane2, vm.memory, pointer, startX, startY, n) || collision;
+      }
+
+      vm.registers[0xF] = collision ? 1 : 0;
+      vm.graphicsAreDirty = true;
+    }
 
-        vm.graphics[offsetY] ^= spriteProjection;
+    void blitHighResolution(VirtualMachine & vm, Instruction instruction) {
+      Nibble x, y, n;
+      Address pointer = vm.I;
+      bool collision = false;
 
-        const auto diff = ~vm.graphics[offsetY] & spriteProjection;
+      std::tie(x, y, n) = getXYN(instruction);
 
-        if(diff != 0) {
-          vm.registers[0xF] = 1;
-        } else {
-          vm.registers[0xF] = 0;
-        }
+      const auto startX = vm.registers[x];
+      const auto startY = vm.registers[y];
+
+      // DXY0 draws a 16x16 sprite stored as two bytes per row.
+      const bool isLargeSprite = n == 0;
+      const std::size_t rows = isLargeSprite ? 16 : n;
+      const std::size_t spriteSize = isLargeSprite ? 32 : n;
+
+      if(vm.selectedPlanes & 0x1) {
+        collision = blitPlane(vm.hiResGraphics, vm.memory, pointer, startX, startY, rows, isLargeSprite);
+        pointer += spriteSize;
+      }
+
+      if(vm.selectedPlanes & 0x2) {
+        collision = blitPlane(vm.hiResGraphicsPlane2, vm.memory, pointer, startX, startY, rows, isLargeSprite) || collision;
       }
 
+      vm.registers[0xF] = collision ? 1 : 0;
       vm.graphicsAreDirty = true;
     }
 
@@ -389,7 +666,7 @@ namespace chip8 {
       auto shouldSkip = vm.keyboard[registerX] == 1;
 
       if(shouldSkip) {
-        vm.programCounter += 2;
+        skipNextInstruction(vm);
       }
     }
 
@@ -402,7 +679,7 @@ namespace chip8 {
       auto shouldSkip = vm.keyboard[registerX] == 0;
 
       if(shouldSkip) {
-        vm.programCounter += 2;
+        skipNextInstruction(vm);
       }
     }
 
@@ -410,6 +687,22 @@ namespace chip8 {
       const auto lowByte = getLowByte(instruction);
 
       switch(lowByte) {
+        case 0x00:
+          if(0xF000 == instruction) {
+            setIToLongAddress(vm, instruction);
+          }
+          break;
+
+        case 0x01:
+          selectPlanes(vm, instruction);
+          break;
+
+        case 0x02:
+          if(0xF002 == instruction) {
+            loadAudioPattern(vm, instruction);
+          }
+          break;
+
         case 0x07:
           setVxToDelayTimer(vm, instruction);
           break;
@@ -430,10 +723,18 @@ namespace chip8 {
           addVxToI(vm, instruction);
           break;
 
+        case 0x3A:
+          setPitch(vm, instruction);
+          break;
+
         case 0x29:
           setIToCharacter(vm, instruction);
           break;
 
+        case 0x30:
+          setIToBigCharacter(vm, instruction);
+          break;
+
         case 0x33:
           storeBcdOfVx(vm, instruction);
           break;
@@ -451,6 +752,25 @@ namespace chip8 {
       }
     }
 
+    // F000 NNNN: the address is the word following the instruction.
+    void setIToLongAddress(VirtualMachine & vm, Instruction instruction) {
+      vm.I = fetch(vm);
+    }
+
+    void selectPlanes(VirtualMachine & vm, Instruction instruction) {
+      Nibble n;
+
+      std::tie(n, std::ignore) = getXY(instruction);
+
+      vm.selectedPlanes = n & 0x3;
+    }
+
+    void loadAudioPattern(VirtualMachine & vm, Instruction instruction) {
+      for(std::size_t i = 0; i < AUDIO_PATTERN_SIZE; i++) {
+        vm.audioPattern[i] = vm.memory[wrapAddress(vm.memory, vm.I + i)];
+      }
+    }
+
     void setVxToDelayTimer(VirtualMachine & vm, Instruction instruction) {
       Byte x;
 
@@ -484,6 +804,14 @@ namespace chip8 {
       vm.timers.sound = vm.registers[x];
     }
 
+    void setPitch(VirtualMachine & vm, Instruction instruction) {
+      Byte x;
+
+      std::tie(x, std::ignore) = getXY(instruction);
+
+      vm.pitch = vm.registers[x];
+    }
+
     void addVxToI(VirtualMachine & vm, Instruction instruction) {
       Byte x;
 
@@ -505,6 +833,15 @@ namespace chip8 {
       vm.I = memoryOffset;
     }
 
+    // FX30: SUPER-CHIP's 8x10 digits, which follow the small font in memory.
+    void setIToBigCharacter(VirtualMachine & vm, Instruction instruction) {
+      Byte x;
+
+      std::tie(x, std::ignore) = getXY(instruction);
+
+      vm.I = BIG_FONT_ADDRESS + (vm.registers[x] & 0xF) * BIG_FONT_GLYPH_SIZE;
+    }
+
     void storeBcdOfVx(VirtualMachine & vm, Instruction instruction) {
       Byte x;
 
@@ -516,9 +853,9 @@ namespace chip8 {
       const Byte tens = (registerX - hundreds * 100) / 10;
       const Byte ones = registerX % 10;
 
-      vm.memory[vm.I] = hundreds;
-      vm.memory[vm.I + 1] = tens;
-      vm.memory[vm.I + 2] = ones;
+      vm.memory[wrapAddress(vm.memory, vm.I)] = hundreds;
+      vm.memory[wrapAddress(vm.memory, vm.I + 1)] = tens;
+      vm.memory[wrapAddress(vm.memory, vm.I + 2)] = ones;
     }
 
     void storeV0ToVx(VirtualMachine & vm, Instruction instruction) {
@@ -532,7 +869,7 @@ namespace chip8 {
 
       // The range includes VX.
       for(std::size_t i = 0; i <= x; i++) {
-        vm.memory[vm.I + i] = vm.registers[i];
+        vm.memory[wrapAddress(vm.memory, vm.I + i)] = vm.registers[i];
       }
     }
 
@@ -547,7 +884,7 @@ namespace chip8 {
 
       // The range includes VX.
       for(std::size_t i = 0; i <= x; i++) {
-        vm.registers[i] = vm.memory[vm.I + i];
+        vm.registers[i] = vm.memory[wrapAddress(vm.memory, vm.I + i)];
       }
     }
   }
@@ -0,0 +1,105 @@
+#include "chip8/Profiler.hpp"
+#include "chip8/Functions.hpp"
+#include "chip8/VirtualMachine.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+namespace chip8 {
+
+  void cycle(VirtualMachine & vm, Profile & profile) {
+    profile.cycles += 1;
+
+    if(vm.awaitingKeypress) {
+      profile.keypressWaitCycles += 1;
+      return;
+    }
+
+    const auto address = vm.programCounter;
+    const auto instruction = fetch(vm);
+
+    if(profile.addressCounts.size() < vm.memory.size()) {
+      profile.addressCounts.resize(vm.memory.size(), 0);
+    }
+
+    profile.addressCounts[address] += 1;
+    profile.opcodeCounts[static_cast<std::size_t>(classify(instruction))] += 1;
+
+    execute(vm, instruction);
+  }
+
+  // Returns the indices of the non-zero entries in counts, hottest first.
+  // Ties keep ascending index order so reports are stable between runs.
+  template <typename Counts>
+  std::vector<std::size_t> sortByCount(const Counts & counts) {
+    std::vector<std::size_t> indices;
+
+    for(std::size_t i = 0; i < counts.size(); i++) {
+      if(counts[i] != 0) {
+        indices.push_back(i);
+      }
+    }
+
+    std::stable_sort(
+      std::begin(indices),
+      std::end(indices),
+      [&counts](std::size_t a, std::size_t b) {
+        return counts[a] > counts[b];
+      }
+    );
+
+    return indices;
+  }
+
+  void printProfileReport(const Profile & profile, std::ostream & out, std::size_t addressLimit) {
+    const auto executed = std::accumulate(
+      std::begin(profile.opcodeCounts),
+      std::end(profile.opcodeCounts),
+      std::uint64_t{0}
+    );
+
+    const auto percentOf = [executed](std::uint64_t count) {
+      return executed == 0 ? 0.0 : (100.0 * count) / executed;
+    };
+
+    const auto flags = out.flags();
+
+    out << "cycles: " << profile.cycles << "\n";
+    out << "instructions executed: " << executed << "\n";
+    out << "cycles waiting for keypress (Fx0A): " << profile.keypressWaitCycles << "\n";
+
+    out << "\nopcode families:\n";
+
+    for(const auto family : sortByCount(profile.opcodeCounts)) {
+      const auto count = profile.opcodeCounts[family];
+
+      out << "  " << std::left << std::setw(30) << getOpcodeFamilyName(static_cast<OpcodeFamily>(family))
+          << std::right << std::setw(14) << count
+          << std::setw(9) << std::fixed << std::setprecision(2) << percentOf(count) << "%\n";
+    }
+
+    const auto addresses = sortByCount(profile.addressCounts);
+    const auto shown = std::min(addressLimit, addresses.size());
+
+    // Like disassembler listings: four digits for all once any needs them.
+    const auto widest = std::max_element(addresses.begin(), addresses.begin() + shown);
+    const int addressDigits = widest != addresses.begin() + shown && *widest > 0xFFF ? 4 : 3;
+
+    out << "\nhot addresses (top " << shown << " of " << addresses.size() << "):\n";
+
+    for(std::size_t i = 0; i < shown; i++) {
+      const auto address = addresses[i];
+      const auto count = profile.addressCounts[address];
+
+      out << "  0x" << std::hex << std::setfill('0') << std::setw(addressDigits) << address
+          << std::dec << std::setfill(' ')
+          << std::setw(14) << count
+          << std::setw(9) << std::fixed << std::setprecision(2) << percentOf(count) << "%\n";
+    }
+
+    out << std::flush;
+    out.flags(flags);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,403 @@
+#include "chip8/Recompiler.hpp"
+#include "AnalysisUtilities.hpp"
+#include "chip8/ControlFlow.hpp"
+#include "chip8/Decoder.hpp"
+#include "chip8/Disassembler.hpp"
+#include "chip8/Functions.hpp"
+#include "chip8/VirtualMachine.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace chip8 {
+
+  bool touchesCode(const RecompiledRom & rom, std::size_t address, std::size_t count) {
+    for(std::size_t i = 0; i < rom.rangeCount; i++) {
+      if(address < rom.ranges[i].end && address + count > rom.ranges[i].start) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  bool matchesCode(const RecompiledRom & rom, const VirtualMachine & vm) {
+    if(vm.xoChip != rom.xoChip || vm.memory.size() < rom.endAddress) {
+      return false;
+    }
+
+    for(std::size_t i = 0; i < rom.rangeCount; i++) {
+      const auto & range = rom.ranges[i];
+
+      if(std::memcmp(&vm.memory[range.start], rom.code + (range.start - rom.firstAddress), range.end - range.start) != 0) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  RecompiledRunner::RecompiledRunner(const RecompiledRom & rom, const VirtualMachine & vm)
+    : rom(rom)
+    , usingBlocks{matchesCode(rom, vm)}
+  {
+
+  }
+
+  void RecompiledRunner::check(const VirtualMachine & vm) {
+    usingBlocks = matchesCode(rom, vm);
+  }
+
+  void RecompiledRunner::run(VirtualMachine & vm, std::size_t cycles) {
+    // Cycles spent waiting on Fx0A don't do anything.
+    while(cycles > 0 && !vm.awaitingKeypress) {
+      const std::size_t offset = vm.programCounter - rom.firstAddress;
+      const RecompiledBlock * block = nullptr;
+
+      if(usingBlocks && vm.programCounter >= rom.firstAddress && vm.programCounter < rom.endAddress) {
+        block = rom.blocks[offset];
+      }
+
+      if(block && block->instructionCount <= cycles) {
+        const auto result = block->run(vm);
+
+        cycles -= result.instructionsRun;
+
+        if(result.storedOverCode) {
+          check(vm);
+        }
+
+        continue;
+      }
+
+      const auto instruction = static_cast<Instruction>((vm.memory[wrapAddress(vm.memory, vm.programCounter)] << 8) | vm.memory[wrapAddress(vm.memory, vm.programCounter + 1)]);
+
+      cycle(vm);
+      cycles -= 1;
+
+      if(analysis::isStore(classify(instruction))) {
+        check(vm);
+      }
+    }
+  }
+
+  namespace {
+
+    using analysis::Hex;
+    using analysis::hexAddress;
+
+    Hex hexInstruction(Instruction instruction) {
+      return Hex{ instruction, 4 };
+    }
+
+    std::string getBlockName(Address start) {
+      std::ostringstream name;
+      name << "block" << hexAddress(start);
+      return name.str();
+    }
+
+    std::string getRegister(Nibble index) {
+      std::ostringstream name;
+      name << "vm.registers[0x" << std::hex << std::uppercase << static_cast<unsigned int>(index) << "]";
+      return name.str();
+    }
+
+    // The condition under which a register-comparing skip is taken, or an
+    // empty string for skips that are left to their handlers.
+    std::string getSkipCondition(OpcodeFamily family, Instruction instruction) {
+      Nibble x, y;
+      std::tie(x, y) = getXY(instruction);
+
+      std::ostringstream condition;
+
+      switch(family) {
+        case OpcodeFamily::skipIfEquals:
+          condition << getRegister(x) << " == " << Hex{ getLowByte(instruction), 2 };
+          break;
+        case OpcodeFamily::skipIfNotEquals:
+          condition << getRegister(x) << " != " << Hex{ getLowByte(instruction), 2 };
+          break;
+        case OpcodeFamily::skipIfVxEqualsVy:
+          condition << getRegister(x) << " == " << getRegister(y);
+          break;
+        case OpcodeFamily::skipIfVxNotEqualsVy:
+          condition << getRegister(x) << " != " << getRegister(y);
+          break;
+        default:
+          break;
+      }
+
+      return condition.str();
+    }
+
+    // Instructions whose handlers read or set the program counter, so it has
+    // to be up to date before they run and they have to end the block.
+    bool usesProgramCounter(OpcodeFamily family) {
+      switch(family) {
+        case OpcodeFamily::returnFromSubroutine:
+        case OpcodeFamily::callProgramAtAddress:
+        case OpcodeFamily::callSubroutine:
+        case OpcodeFamily::jumpPlusV0:
+        case OpcodeFamily::skipIfEquals:
+        case OpcodeFamily::skipIfNotEquals:
+        case OpcodeFamily::skipIfVxEqualsVy:
+        case OpcodeFamily::skipIfVxNotEqualsVy:
+        case OpcodeFamily::skipIfKeyIsPressed:
+        case OpcodeFamily::skipIfKeyIsNotPressed:
+        case OpcodeFamily::waitForKeyPress:
+        case OpcodeFamily::setIToLongAddress:
+        case OpcodeFamily::unknown:
+          return true;
+        default:
+          return false;
+      }
+    }
+
+    // Writes the statements for one instruction. Simple register, timer and
+    // I updates are written out in place; everything else calls its ops::
+    // handler with the instruction as a constant. Returns whether they end
+    // by returning from the block.
+    bool writeInstruction(
+      std::ostream & out,
+      const std::string & romName,
+      const BasicBlock & block,
+      Address address,
+      Instruction instruction,
+      OpcodeFamily family,
+      Address next,
+      Address longAddress,
+      std::size_t count
+    ) {
+      Nibble x, y;
+      std::tie(x, y) = getXY(instruction);
+
+      const auto vx = getRegister(x);
+      const auto vy = getRegister(y);
+
+      out << "    // " << hexAddress(address) << ": " << disassemble(instruction, longAddress).c_str() << "\n";
+
+      switch(family) {
+        case OpcodeFamily::setVx:
+          out << "    " << vx << " = " << Hex{ getLowByte(instruction), 2 } << ";\n";
+          return false;
+        case OpcodeFamily::addToVx:
+          out << "    " << vx << " += " << Hex{ getLowByte(instruction), 2 } << ";\n";
+          return false;
+        case OpcodeFamily::setVxToVy:
+          out << "    " << vx << " = " << vy << ";\n";
+          return false;
+        case OpcodeFamily::orVxVy:
+          out << "    " << vx << " |= " << vy << ";\n";
+          return false;
+        case OpcodeFamily::andVxVy:
+          out << "    " << vx << " &= " << vy << ";\n";
+          return false;
+        case OpcodeFamily::xorVxVy:
+          out << "    " << vx << " ^= " << vy << ";\n";
+          return false;
+        case OpcodeFamily::setIToAddress:
+          out << "    vm.I = " << hexAddress(getAddress(instruction)) << ";\n";
+          return false;
+        case OpcodeFamily::addVxToI:
+          out << "    vm.I += " << vx << ";\n";
+          return false;
+        case OpcodeFamily::setVxToDelayTimer:
+          out << "    " << vx << " = vm.timers.delay;\n";
+          return false;
+        case OpcodeFamily::setDelayTimer:
+          out << "    vm.timers.delay = " << vx << ";\n";
+          return false;
+        case OpcodeFamily::setSoundTimer:
+          out << "    vm.timers.sound = " << vx << ";\n";
+          return false;
+        case OpcodeFamily::jump:
+          out << "    vm.programCounter = " << hexAddress(getAddress(instruction)) << ";\n"
+              << "    return { " << count << ", false };\n";
+          return true;
+        default:
+          break;
+      }
+
+      // XO-CHIP's F000 NNNN, whose address the walk has already read.
+      if(family == OpcodeFamily::setIToLongAddress && next == address + 4) {
+        out << "    vm.I = " << Hex{ longAddress, 4 } << ";\n";
+        return false;
+      }
+
+      const auto condition = getSkipCondition(family, instruction);
+
+      if(!condition.empty()) {
+        for(const auto & edge : block.successors) {
+          if(edge.kind == EdgeKind::Branch) {
+            out << "    vm.programCounter = (" << condition << ") ? " << hexAddress(edge.target) << " : " << hexAddress(next) << ";\n"
+                << "    return { " << count << ", false };\n";
+            return true;
+          }
+        }
+      }
+
+      if(usesProgramCounter(family)) {
+        out << "    vm.programCounter = " << hexAddress(next) << ";\n";
+      }
+
+      if(family == OpcodeFamily::unknown) {
+        out << "    execute(vm, " << hexInstruction(instruction) << ");\n";
+      } else {
+        out << "    ops::" << getOpcodeFamilyName(family) << "(vm, " << hexInstruction(instruction) << ");\n";
+      }
+
+      if(usesProgramCounter(family)) {
+        out << "    return { " << count << ", false };\n";
+        return true;
+      }
+
+      const auto storeLength = analysis::getStoreLength(family, instruction);
+
+      if(storeLength > 0) {
+        out << "    if(touchesCode(" << romName << ", vm.I, " << storeLength << ")) {\n"
+            << "      vm.programCounter = " << hexAddress(next) << ";\n"
+            << "      return { " << count << ", true };\n"
+            << "    }\n";
+      }
+
+      return false;
+    }
+
+    // The length the walk gave the instruction at address: four bytes for
+    // XO-CHIP's F000 NNNN, two for everything else.
+    Address getInstructionLength(const Memory & memory, Address address, bool xoChip) {
+      const auto instruction = static_cast<Instruction>((memory[address] << 8) | memory[address + 1]);
+
+      if(xoChip && classify(instruction) == OpcodeFamily::setIToLongAddress && std::size_t{address} + 4 <= memory.size()) {
+        return 4;
+      }
+
+      return 2;
+    }
+
+  }
+
+  void writeRecompiledRom(const ControlFlowGraph & graph, const Memory & memory, const std::string & name, std::ostream & out) {
+    if(graph.blocks.empty()) {
+      throw std::runtime_error("Cannot recompile a rom with no reachable code");
+    }
+
+    const Address firstAddress = graph.blocks.begin()->first;
+    Address endAddress = firstAddress;
+
+    // Instruction bytes, merged into runs.
+    std::vector<RecompiledRange> ranges;
+
+    for(const auto & entry : graph.blocks) {
+      const auto & block = entry.second;
+
+      const auto end = static_cast<Address>(std::min<std::size_t>(block.end, memory.size()));
+
+      endAddress = std::max(endAddress, end);
+
+      if(!ranges.empty() && block.start <= ranges.back().end) {
+        ranges.back().end = std::max(ranges.back().end, end);
+      } else {
+        ranges.push_back(RecompiledRange{ block.start, end });
+      }
+    }
+
+    out << "// Generated by chip8-recompile from " << graph.blocks.size() << " basic blocks. Do not edit.\n"
+        << "#include \"chip8/Functions.hpp\"\n"
+        << "#include \"chip8/Opcodes.hpp\"\n"
+        << "#include \"chip8/Recompiler.hpp\"\n"
+        << "#include \"chip8/VirtualMachine.hpp\"\n"
+        << "\n"
+        << "extern const chip8::RecompiledRom " << name << ";\n"
+        << "\n"
+        << "namespace {\n"
+        << "  using namespace chip8;\n";
+
+    for(const auto & entry : graph.blocks) {
+      const auto & block = entry.second;
+      Address address = block.start;
+
+      out << "\n  RecompiledBlockResult " << getBlockName(block.start) << "(VirtualMachine & vm) {\n";
+
+      bool returned = false;
+
+      for(std::size_t count = 1; count <= block.instructionCount; count++) {
+        const auto instruction = static_cast<Instruction>((memory[address] << 8) | memory[address + 1]);
+        auto family = classify(instruction);
+        const Address next = address + getInstructionLength(memory, address, graph.xoChip);
+        const Address longAddress = next == address + 4 ? static_cast<Address>((memory[address + 2] << 8) | memory[address + 3]) : 0;
+
+        // Outside of XO-CHIP the walk treats F000 as the end of the road,
+        // and so does the recompiled block: the interpreter takes over.
+        if(family == OpcodeFamily::setIToLongAddress && next != address + 4) {
+          family = OpcodeFamily::unknown;
+        }
+
+        returned = writeInstruction(out, name, block, address, instruction, family, next, longAddress, count);
+        address = next;
+      }
+
+      // Blocks that end on a jump, skip, call or return have already said
+      // where to go next.
+      if(!returned) {
+        out << "    vm.programCounter = " << hexAddress(block.end) << ";\n"
+            << "    return { " << block.instructionCount << ", false };\n";
+      }
+
+      out << "  }\n";
+    }
+
+    out << "\n  const RecompiledBlock BLOCKS[] = {\n";
+
+    for(const auto & entry : graph.blocks) {
+      out << "    { " << hexAddress(entry.first) << ", " << entry.second.instructionCount << ", " << getBlockName(entry.first) << " },\n";
+    }
+
+    out << "  };\n"
+        << "\n  const RecompiledBlock * const BLOCKS_BY_ADDRESS[] = {";
+
+    std::size_t index = 0;
+
+    for(std::size_t address = firstAddress; address < endAddress; address++) {
+      out << (address % 8 == 0 ? "\n    " : " ");
+
+      if(graph.blocks.count(static_cast<Address>(address))) {
+        out << "&BLOCKS[" << index++ << "],";
+      } else {
+        out << "nullptr,";
+      }
+    }
+
+    out << "\n  };\n"
+        << "\n  const Byte CODE[] = {";
+
+    for(std::size_t address = firstAddress; address < endAddress; address++) {
+      out << (address % 16 == 0 ? "\n    " : " ") << Hex{ memory[address], 2 } << ",";
+    }
+
+    out << "\n  };\n"
+        << "\n  const RecompiledRange RANGES[] = {\n";
+
+    for(const auto & range : ranges) {
+      out << "    { " << hexAddress(range.start) << ", " << hexAddress(range.end) << " },\n";
+    }
+
+    out << "  };\n"
+        << "}\n"
+        << "\n"
+        << "const chip8::RecompiledRom " << name << " {\n"
+        << "  \"" << name << "\",\n"
+        << "  " << (graph.xoChip ? "true" : "false") << ",\n"
+        << "  " << hexAddress(firstAddress) << ",\n"
+        << "  " << hexAddress(endAddress) << ",\n"
+        << "  CODE,\n"
+        << "  RANGES,\n"
+        << "  " << ranges.size() << ",\n"
+        << "  BLOCKS_BY_ADDRESS\n"
+        << "};\n";
+  }
+}
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include "chip8/Scrolling.hpp"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CHIP8_SCROLL_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace chip8 {
+
+  namespace {
+    template <typename Buffer>
+    void moveRowsDown(Buffer & plane, std::size_t rows) {
+      rows = std::min(rows, plane.size());
+
+      std::memmove(&plane[rows], &plane[0], (plane.size() - rows) * sizeof(plane[0]));
+      std::fill(std::begin(plane), std::begin(plane) + rows, typename Buffer::value_type{});
+    }
+
+    template <typename Buffer>
+    void moveRowsUp(Buffer & plane, std::size_t rows) {
+      rows = std::min(rows, plane.size());
+
+      std::memmove(&plane[0], &plane[rows], (plane.size() - rows) * sizeof(plane[0]));
+      std::fill(std::end(plane) - rows, std::end(plane), typename Buffer::value_type{});
+    }
+  }
+
+  void scrollPlaneDown(GraphicsBuffer & plane, std::size_t rows) {
+    moveRowsDown(plane, rows);
+  }
+
+  void scrollPlaneDown(HiResGraphicsBuffer & plane, std::size_t rows) {
+    moveRowsDown(plane, rows);
+  }
+
+  void scrollPlaneUp(GraphicsBuffer & plane, std::size_t rows) {
+    moveRowsUp(plane, rows);
+  }
+
+  void scrollPlaneUp(HiResGraphicsBuffer & plane, std::size_t rows) {
+    moveRowsUp(plane, rows);
+  }
+
+#if defined(CHIP8_SCROLL_SSE2)
+
+  // Low resolution rows are independent, so each 128 bit register holds two
+  // rows and both lanes shift by the same count. Both buffers have an even
+  // number of rows.
+  void scrollPlaneRight(GraphicsBuffer & plane, unsigned int pixels) {
+    const auto count = _mm_cvtsi32_si128(pixels);
+    auto * rows = reinterpret_cast<__m128i *>(plane.data());
+
+    for(std::size_t i = 0; i < plane.size() / 2; i++) {
+      _mm_storeu_si128(rows + i, _mm_srl_epi64(_mm_loadu_si128(rows + i), count));
+    }
+  }
+
+  void scrollPlaneLeft(GraphicsBuffer & plane, unsigned int pixels) {
+    const auto count = _mm_cvtsi32_si128(pixels);
+    auto * rows = reinterpret_cast<__m128i *>(plane.data());
+
+    for(std::size_t i = 0; i < plane.size() / 2; i++) {
+      _mm_storeu_si128(rows + i, _mm_sll_epi64(_mm_loadu_si128(rows + i), count));
+    }
+  }
+
+  // A high resolution row fills one register: the left word in the low lane
+  // and the right word in the high lane. Both lanes shift, then the bits
+  // pushed out of the left word are moved into the right one with a byte
+  // shift across lanes. Shift counts of 64 yield zero in SSE2, so no
+  // special case is needed for pixels == 0.
+  void scrollPlaneRight(HiResGraphicsBuffer & plane, unsigned int pixels) {
+    const auto count = _mm_cvtsi32_si128(pixels);
+    const auto carryCount = _mm_cvtsi32_si128(64 - pixels);
+    auto * rows = reinterpret_cast<__m128i *>(plane.data());
+
+    // Two independent rows per iteration keep both shift units busy.
+    for(std::size_t i = 0; i < plane.size(); i += 2) {
+      const auto first = _mm_loadu_si128(rows + i);
+      const auto second = _mm_loadu_si128(rows + i + 1);
+      const auto firstCarry = _mm_slli_si128(_mm_sll_epi64(first, carryCount), 8);
+      const auto secondCarry = _mm_slli_si128(_mm_sll_epi64(second, carryCount), 8);
+
+      _mm_storeu_si128(rows + i, _mm_or_si128(_mm_srl_epi64(first, count), firstCarry));
+      _mm_storeu_si128(rows + i + 1, _mm_or_si128(_mm_srl_epi64(second, count), secondCarry));
+    }
+  }
+
+  void scrollPlaneLeft(HiResGraphicsBuffer & plane, unsigned int pixels) {
+    const auto count = _mm_cvtsi32_si128(pixels);
+    const auto carryCount = _mm_cvtsi32_si128(64 - pixels);
+    auto * rows = reinterpret_cast<__m128i *>(plane.data());
+
+    for(std::size_t i = 0; i < plane.size(); i += 2) {
+      const auto first = _mm_loadu_si128(rows + i);
+      const auto second = _mm_loadu_si128(rows + i + 1);
+      const auto firstCarry = _mm_srli_si128(_mm_srl_epi64(first, carryCount), 8);
+      const auto secondCarry = _mm_srli_si128(_mm_srl_epi64(second, carryCount), 8);
+
+      _mm_storeu_si128(rows + i, _mm_or_si128(_mm_sll_epi64(first, count), firstCarry));
+      _mm_storeu_si128(rows + i + 1, _mm_or_si128(_mm_sll_epi64(second, count), secondCarry));
+    }
+  }
+
+#else
+
+  void scrollPlaneRight(GraphicsBuffer & plane, unsigned int pixels) {
+    scalar::scrollPlaneRight(plane, pixels);
+  }
+
+  void scrollPlaneRight(HiResGraphicsBuffer & plane, unsigned int pixels) {
+    scalar::scrollPlaneRight(plane, pixels);
+  }
+
+  void scrollPlaneLeft(GraphicsBuffer & plane, unsigned int pixels) {
+    scalar::scrollPlaneLeft(plane, pixels);
+  }
+
+  void scrollPlaneLeft(HiResGraphicsBuffer & plane, unsigned int pixels) {
+    scalar::scrollPlaneLeft(plane, pixels);
+  }
+
+#endif
+
+  namespace scalar {
+    void scrollPlaneRight(GraphicsBuffer & plane, unsigned int pixels) {
+      for(auto & row : plane) {
+        row = row >> pixels;
+      }
+    }
+
+    void scrollPlaneRight(HiResGraphicsBuffer & plane, unsigned int pixels) {
+      if(pixels == 0) {
+        return;
+      }
+
+      for(auto & row : plane) {
+        // The pixels leaving the left word enter the right one.
+        row[1] = (row[1] >> pixels) | (row[0] << (64 - pixels));
+        row[0] = row[0] >> pixels;
+      }
+    }
+
+    void scrollPlaneLeft(GraphicsBuffer & plane, unsigned int pixels) {
+      for(auto & row : plane) {
+        row = row << pixels;
+      }
+    }
+
+    void scrollPlaneLeft(HiResGraphicsBuffer & plane, unsigned int pixels) {
+      if(pixels == 0) {
+        return;
+      }
+
+      for(auto & row : plane) {
+        row[0] = (row[0] << pixels) | (row[1] >> (64 - pixels));
+        row[1] = row[1] << pixels;
+      }
+    }
+  }
+}
\ No newline at end of file
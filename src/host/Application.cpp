@@ -1,23 +1,47 @@
 #include "host/Application.hpp"
 #include "host/ToneGenerator.hpp"
 #include "chip8/Functions.hpp"
+#include "chip8/Profiler.hpp"
 #include "chip8/VirtualMachine.hpp"
+#include <algorithm>
 #include <iostream>
-#include <chrono>
 
 namespace host {
 
-  Application::Application(chip8::VirtualMachine & vm)
+  Keymap readKeymap(std::istream & config) {
+    Keymap keymap;
+
+    keymap.load(
+      config,
+      [](const std::string & name) {
+        return static_cast<int>(SDL_GetScancodeFromName(name.c_str()));
+      },
+      [](const std::string & name) {
+        return static_cast<int>(SDL_GameControllerGetButtonFromString(name.c_str()));
+      }
+    );
+
+    return keymap;
+  }
+
+  Application::Application(chip8::VirtualMachine & vm, const Keymap & keymap, chip8::Profile * profile, std::uint16_t audioBufferFrames)
     : vm{vm}
+    , profile{profile}
     , window{nullptr, &SDL_DestroyWindow}
     , renderer{nullptr, &SDL_DestroyRenderer}
+    , gamepad{nullptr, &SDL_GameControllerClose}
+    , keymap{keymap}
     , event{}
     , pixelRect{}
     , quit{false}
     , paused{false}
     , enableSound{true}
+    , audioBufferFrames{audioBufferFrames}
+    , clock{}
+    , lastTicks{0}
+    , targetTick{0}
   {
-    if(SDL_Init(SDL_INIT_AUDIO | SDL_INIT_VIDEO) < 0){
+    if(SDL_Init(SDL_INIT_AUDIO | SDL_INIT_VIDEO | SDL_INIT_GAMECONTROLLER) < 0){
       std::cout << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
     }
 
@@ -37,11 +61,12 @@ namespace host {
   }
 
   Application::~Application() {
+    gamepad.reset();
     SDL_Quit();
   }
 
   int Application::run() {
-    ToneGenerator toneGenerator;
+    ToneGenerator toneGenerator{audioBufferFrames};
 
     chip8::reset(vm);
 
@@ -59,53 +84,29 @@ namespace host {
         SDL_RenderClear(renderer.get());
       }
 
-      // timers @ 60Hz
-      using FramePeriod = std::chrono::duration<long long, std::ratio<1, 60>>;
-      auto prevFrame = std::chrono::high_resolution_clock::now();
-      auto currentFrame = prevFrame;
-
-      // CPU cycles @ 500Hz
-      using CyclePeriod = std::chrono::duration<long long, std::ratio<1, 500>>;
-      auto prevCycle = std::chrono::high_resolution_clock::now();
-      auto currentCycle = prevCycle;
+      lastTicks = SDL_GetTicks();
 
       while(!quit) {
-        handleEvents();
+        if(paused || (vm.awaitingKeypress && !clock.hasPendingInput())) {
+          waitForEvent();
+        }
 
-        currentFrame = std::chrono::high_resolution_clock::now();
-        auto frameDifference = currentFrame - prevFrame;
+        const auto ticks = SDL_GetTicks();
 
-        currentCycle = std::chrono::high_resolution_clock::now();
-        auto cycleDifference = currentCycle - prevCycle;
+        handleEvents();
 
         if(!paused) {
-          if(frameDifference > FramePeriod{1}) {
-            prevFrame = currentFrame;
-
-            if(vm.timers.delay > 0) {
-              vm.timers.delay -= 1;
-            }
-
-            if(vm.timers.sound > 0) {
-              vm.timers.sound -= 1;
-            }
-          }
-
-          if(enableSound) {
-            if(vm.timers.sound > 0) {
-              toneGenerator.activate();
-            } else {
-              toneGenerator.deactivate();
-            }
-          }
-
-          if(cycleDifference > CyclePeriod{1}) {
-            prevCycle = currentCycle;
-            updateEmulator();
-          }
+          // Emulated time follows SDL's millisecond clock, the one event
+          // timestamps are on. After a stall it only catches up so far.
+          const auto elapsed = std::min<Uint32>(ticks - lastTicks, MAX_CATCH_UP_MILLISECONDS);
 
+          targetTick += elapsed * CLOCK_TICKS_PER_SECOND / 1000;
+          clock.advanceTo(targetTick, vm, profile);
+          updateAudio(toneGenerator, vm, enableSound, clock.getCycles());
           updateScreen();
         }
+
+        lastTicks = ticks;
       }
     }
 
@@ -114,131 +115,69 @@ namespace host {
 
   void Application::handleEvents() {
     while(SDL_PollEvent(&event)) {
-      if(event.type == SDL_QUIT) {
-        quit = true;
-      } else if(event.type == SDL_WINDOWEVENT) {
-        switch(event.window.event) {
-          case SDL_WINDOWEVENT_FOCUS_GAINED:
-            paused = false;
-            break;
-          case SDL_WINDOWEVENT_FOCUS_LOST:
-            paused = true;
-            break;
-          default:
-            break;
-        }
-      } else if(event.type == SDL_KEYDOWN) {
-        switch(event.key.keysym.sym) {
-          case SDLK_1:
-            chip8::handleKeypress(vm, 0x0);
-            break;
-          case SDLK_2:
-            chip8::handleKeypress(vm, 0x1);
-            break;
-          case SDLK_3:
-            chip8::handleKeypress(vm, 0x2);
-            break;
-          case SDLK_4:
-            chip8::handleKeypress(vm, 0x3);
-            break;
-          case SDLK_q:
-            chip8::handleKeypress(vm, 0x4);
-            break;
-          case SDLK_w:
-            chip8::handleKeypress(vm, 0x5);
-            break;
-          case SDLK_e:
-            chip8::handleKeypress(vm, 0x6);
-            break;
-          case SDLK_r:
-            chip8::handleKeypress(vm, 0x7);
-            break;
-          case SDLK_a:
-            chip8::handleKeypress(vm, 0x8);
-            break;
-          case SDLK_s:
-            chip8::handleKeypress(vm, 0x9);
-            break;
-          case SDLK_d:
-            chip8::handleKeypress(vm, 0xA);
-            break;
-          case SDLK_f:
-            chip8::handleKeypress(vm, 0xB);
-            break;
-          case SDLK_z:
-            chip8::handleKeypress(vm, 0xC);
-            break;
-          case SDLK_x:
-            chip8::handleKeypress(vm, 0xD);
-            break;
-          case SDLK_c:
-            chip8::handleKeypress(vm, 0xE);
-            break;
-          case SDLK_v:
-            chip8::handleKeypress(vm, 0xF);
-            break;
-          default:
-            break;
-        }
-      } else if(event.type == SDL_KEYUP) {
-        switch(event.key.keysym.sym) {
-          case SDLK_1:
-            chip8::handleKeyRelease(vm, 0x0);
-            break;
-          case SDLK_2:
-            chip8::handleKeyRelease(vm, 0x1);
-            break;
-          case SDLK_3:
-            chip8::handleKeyRelease(vm, 0x2);
-            break;
-          case SDLK_4:
-            chip8::handleKeyRelease(vm, 0x3);
-            break;
-          case SDLK_q:
-            chip8::handleKeyRelease(vm, 0x4);
-            break;
-          case SDLK_w:
-            chip8::handleKeyRelease(vm, 0x5);
-            break;
-          case SDLK_e:
-            chip8::handleKeyRelease(vm, 0x6);
-            break;
-          case SDLK_r:
-            chip8::handleKeyRelease(vm, 0x7);
-            break;
-          case SDLK_a:
-            chip8::handleKeyRelease(vm, 0x8);
-            break;
-          case SDLK_s:
-            chip8::handleKeyRelease(vm, 0x9);
-            break;
-          case SDLK_d:
-            chip8::handleKeyRelease(vm, 0xA);
-            break;
-          case SDLK_f:
-            chip8::handleKeyRelease(vm, 0xB);
-            break;
-          case SDLK_z:
-            chip8::handleKeyRelease(vm, 0xC);
-            break;
-          case SDLK_x:
-            chip8::handleKeyRelease(vm, 0xD);
-            break;
-          case SDLK_c:
-            chip8::handleKeyRelease(vm, 0xE);
-            break;
-          case SDLK_v:
-            chip8::handleKeyRelease(vm, 0xF);
-            break;
-          default:
-            break;
-        }
+      handleEvent();
+    }
+  }
+
+  // Blocks until an event arrives, for when emulating would change nothing
+  // else. In the background emulated time stands still, so only an event
+  // can end the wait. While the rom waits on Fx0A with no input queued, the
+  // timers still count down, so it also ends at the next 60Hz update.
+  void Application::waitForEvent() {
+    if(paused) {
+      if(SDL_WaitEvent(&event)) {
+        handleEvent();
+      }
+
+      return;
+    }
+
+    const auto ticksToWait = clock.getNextTimerUpdate() - clock.getNow();
+    const auto millisecondsToWait = std::max<std::uint64_t>((ticksToWait * 1000 + CLOCK_TICKS_PER_SECOND - 1) / CLOCK_TICKS_PER_SECOND, 1);
+
+    if(SDL_WaitEventTimeout(&event, static_cast<int>(millisecondsToWait))) {
+      handleEvent();
+    }
+  }
+
+  void Application::handleEvent() {
+    if(event.type == SDL_QUIT) {
+      quit = true;
+    } else if(event.type == SDL_WINDOWEVENT) {
+      switch(event.window.event) {
+        case SDL_WINDOWEVENT_FOCUS_GAINED:
+          paused = false;
+          break;
+        case SDL_WINDOWEVENT_FOCUS_LOST:
+          paused = true;
+          break;
+        default:
+          break;
+      }
+    } else if(event.type == SDL_KEYDOWN || event.type == SDL_KEYUP) {
+      setKey(keymap.keyForScancode(event.key.keysym.scancode), event.type == SDL_KEYDOWN, event.key.timestamp);
+    } else if(event.type == SDL_CONTROLLERBUTTONDOWN || event.type == SDL_CONTROLLERBUTTONUP) {
+      setKey(keymap.keyForButton(event.cbutton.button), event.type == SDL_CONTROLLERBUTTONDOWN, event.cbutton.timestamp);
+    } else if(event.type == SDL_CONTROLLERDEVICEADDED) {
+      // Also sent for controllers already connected at startup.
+      if(!gamepad && SDL_IsGameController(event.cdevice.which)) {
+        gamepad.reset(SDL_GameControllerOpen(event.cdevice.which));
       }
     }
   }
 
-  void Application::updateEmulator() {
-    chip8::cycle(vm);
+  // Queues the change for the emulated tick matching when SDL saw it:
+  // events are stamped during the previous catch-up interval, which started
+  // at lastTicks and targetTick.
+  void Application::setKey(std::int8_t key, bool pressed, Uint32 timestamp) {
+    if(key == UNBOUND_KEY) {
+      return;
+    }
+
+    const auto sinceLastUpdate = std::max<Sint32>(static_cast<Sint32>(timestamp - lastTicks), 0);
+    const auto tick = targetTick + static_cast<std::uint64_t>(sinceLastUpdate) * CLOCK_TICKS_PER_SECOND / 1000;
+
+    clock.queueInput(tick, static_cast<chip8::Byte>(key), pressed);
   }
 
   void Application::updateScreen() {
@@ -246,26 +185,23 @@ namespace host {
       // Clear screen with black.
       SDL_SetRenderDrawColor(renderer.get(), 0, 0, 0, SDL_ALPHA_OPAQUE);
       SDL_RenderClear(renderer.get());
-      SDL_SetRenderDrawColor(renderer.get(), 255, 255, 255, SDL_ALPHA_OPAQUE);
 
       // Draw VM's graphics memory to screen.
-      const auto & graphics = vm.graphics;
-      const auto rows = graphics.size();
-
-      for(std::size_t y = 0; y < rows; y++) {
-        const auto pixels = graphics[y];
-        std::uint64_t pixelMask = 0b1000000000000000000000000000000000000000000000000000000000000000;
-
-        for(std::size_t x = 0, size = sizeof(pixels) * 8; x < size; x++) {
-          bool isToggled = (pixels & pixelMask) != 0;
-
-          if(isToggled) {
-            pixelRect.x = x * 10;
-            pixelRect.y = y * 10;
-            SDL_RenderFillRect(renderer.get(), &pixelRect);
-          }
+      if(vm.highResolution) {
+        // Half-size pixels so the 128x64 screen covers the same area.
+        const auto & plane1 = vm.hiResGraphics;
+        const auto & plane2 = vm.hiResGraphicsPlane2;
+
+        for(std::size_t y = 0, rows = plane1.size(); y < rows; y++) {
+          drawRow(plane1[y][0], plane2[y][0], 0, y, 5);
+          drawRow(plane1[y][1], plane2[y][1], 64, y, 5);
+        }
+      } else {
+        const auto & plane1 = vm.graphics;
+        const auto & plane2 = vm.graphicsPlane2;
 
-          pixelMask >>= 1;
+        for(std::size_t y = 0, rows = plane1.size(); y < rows; y++) {
+          drawRow(plane1[y], plane2[y], 0, y, 10);
         }
       }
 
@@ -276,4 +212,43 @@ namespace host {
     }
   }
 
+  // Draws one 64 pixel word of a row. The colour of each pixel is its bit in
+  // plane 1 plus twice its bit in plane 2; the three non-black colours are
+  // separated with whole-word masks, so rows without plane 2 pixels cost
+  // the same as monochrome ones.
+  void Application::drawRow(std::uint64_t plane1, std::uint64_t plane2, std::size_t left, std::size_t y, int pixelSize) {
+    const std::uint64_t colourMasks[PALETTE_SIZE - 1] = {
+      plane1 & ~plane2,
+      ~plane1 & plane2,
+      plane1 & plane2
+    };
+
+    pixelRect.w = pixelSize;
+    pixelRect.h = pixelSize;
+    pixelRect.y = y * pixelSize;
+
+    for(std::size_t colour = 0; colour < PALETTE_SIZE - 1; colour++) {
+      auto pixels = colourMasks[colour];
+
+      if(pixels == 0) {
+        continue;
+      }
+
+      const auto & rgb = PALETTE[colour + 1];
+      SDL_SetRenderDrawColor(renderer.get(), rgb[0], rgb[1], rgb[2], SDL_ALPHA_OPAQUE);
+
+      std::uint64_t pixelMask = 0b1000000000000000000000000000000000000000000000000000000000000000;
+
+      for(std::size_t x = 0; pixels != 0; x++) {
+        if((pixels & pixelMask) != 0) {
+          pixelRect.x = (left + x) * pixelSize;
+          SDL_RenderFillRect(renderer.get(), &pixelRect);
+          pixels &= ~pixelMask;
+        }
+
+        pixelMask >>= 1;
+      }
+    }
+  }
+
 }
\ No newline at end of file
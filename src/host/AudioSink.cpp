@@ -0,0 +1,40 @@
+#include "host/AudioSink.hpp"
+#include "chip8/VirtualMachine.hpp"
+
+namespace host {
+
+  AudioSink::AudioSink()
+    : state{}
+  {
+
+  }
+
+  AudioSink::~AudioSink() {
+
+  }
+
+  void AudioSink::setSounding(bool on, std::uint64_t cycle) {
+    if(on != state.on) {
+      state.on = on;
+      queue(state, cycle);
+    }
+  }
+
+  void AudioSink::setPattern(const chip8::ByteArray<chip8::AUDIO_PATTERN_SIZE> & pattern, chip8::Byte pitch, std::uint64_t cycle) {
+    if(!state.usePattern || pitch != state.pitch || pattern != state.pattern) {
+      state.usePattern = true;
+      state.pitch = pitch;
+      state.pattern = pattern;
+      queue(state, cycle);
+    }
+  }
+
+  void updateAudio(AudioSink & sink, const chip8::VirtualMachine & vm, bool enabled, std::uint64_t cycle) {
+    if(vm.xoChip) {
+      sink.setPattern(vm.audioPattern, vm.pitch, cycle);
+    }
+
+    sink.setSounding(enabled && vm.timers.sound > 0, cycle);
+  }
+
+}
\ No newline at end of file
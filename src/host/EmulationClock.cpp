@@ -0,0 +1,122 @@
+#include "host/EmulationClock.hpp"
+#include "chip8/Functions.hpp"
+#include "chip8/Profiler.hpp"
+#include "chip8/VirtualMachine.hpp"
+#include <algorithm>
+
+namespace host {
+
+  namespace {
+
+    // How many multiples of period lie in [from, to).
+    std::uint64_t multiplesBetween(std::uint64_t from, std::uint64_t to, std::uint64_t period) {
+      return (to + period - 1) / period - (from + period - 1) / period;
+    }
+
+  }
+
+  EmulationClock::EmulationClock()
+    : input{}
+    , pressedSinceCycle{}
+    , now{0}
+    , cycles{0}
+  {
+
+  }
+
+  void EmulationClock::queueInput(std::uint64_t tick, chip8::Byte key, bool pressed) {
+    const auto earliest = input.empty() ? now : std::max(now, input.back().tick);
+
+    input.push_back(InputEvent{std::max(tick, earliest), key, pressed});
+  }
+
+  // Applies the input due by now. Returns false if it stopped early at a
+  // release that has to wait for a cycle.
+  bool EmulationClock::applyInput(chip8::VirtualMachine & vm) {
+    while(!input.empty() && input.front().tick <= now) {
+      const auto & event = input.front();
+
+      if(event.pressed) {
+        chip8::handleKeypress(vm, event.key);
+        pressedSinceCycle[event.key] = true;
+      } else if(pressedSinceCycle[event.key]) {
+        return false;
+      } else {
+        chip8::handleKeyRelease(vm, event.key);
+      }
+
+      input.pop_front();
+    }
+
+    return true;
+  }
+
+  // While the rom waits on Fx0A every cycle is a no-op until the next key
+  // press, so jump straight there (or to target), counting the cycles as
+  // waited and the timers down in one step.
+  void EmulationClock::fastForward(std::uint64_t target, chip8::VirtualMachine & vm, chip8::Profile * profile) {
+    const auto end = input.empty() ? target : std::min(target, input.front().tick);
+    const auto waited = multiplesBetween(now, end, CLOCK_TICKS_PER_CYCLE);
+    const auto timerUpdates = multiplesBetween(now, end, CLOCK_TICKS_PER_TIMER_UPDATE);
+
+    cycles += waited;
+
+    if(profile) {
+      profile->cycles += waited;
+      profile->keypressWaitCycles += waited;
+    }
+
+    vm.timers.delay = static_cast<chip8::Byte>(vm.timers.delay - std::min<std::uint64_t>(vm.timers.delay, timerUpdates));
+    vm.timers.sound = static_cast<chip8::Byte>(vm.timers.sound - std::min<std::uint64_t>(vm.timers.sound, timerUpdates));
+
+    if(waited > 0) {
+      pressedSinceCycle.reset();
+    }
+
+    now = end;
+  }
+
+  void EmulationClock::advanceTo(std::uint64_t target, chip8::VirtualMachine & vm, chip8::Profile * profile) {
+    while(now < target) {
+      const bool cycleDue = now % CLOCK_TICKS_PER_CYCLE == 0;
+
+      applyInput(vm);
+
+      if(vm.awaitingKeypress && (input.empty() || input.front().tick > now)) {
+        fastForward(target, vm, profile);
+        continue;
+      }
+
+      if(now % CLOCK_TICKS_PER_TIMER_UPDATE == 0) {
+        chip8::updateTimers(vm);
+      }
+
+      if(cycleDue) {
+        if(profile) {
+          chip8::cycle(vm, *profile);
+        } else {
+          chip8::cycle(vm);
+        }
+
+        cycles++;
+        pressedSinceCycle.reset();
+
+        // Releases held back for this cycle.
+        applyInput(vm);
+      }
+
+      // Skip to the next tick where something happens.
+      auto next = std::min(
+        (now / CLOCK_TICKS_PER_CYCLE + 1) * CLOCK_TICKS_PER_CYCLE,
+        (now / CLOCK_TICKS_PER_TIMER_UPDATE + 1) * CLOCK_TICKS_PER_TIMER_UPDATE
+      );
+
+      if(!input.empty() && input.front().tick > now) {
+        next = std::min(next, input.front().tick);
+      }
+
+      now = std::min(next, target);
+    }
+  }
+
+}
\ No newline at end of file
@@ -1,14 +1,24 @@
 #include "host/FileUtilities.hpp"
+#include "chip8/Constants.hpp"
+#include "chip8/VirtualMachine.hpp"
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CHIP8_HAVE_POSIX_IO 1
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace host {
 
   const std::vector<char> readFileAsChar(const std::string & filePath) {
     std::ifstream file;
 
-    file.open(filePath);
+    file.open(filePath, std::ios::binary);
 
     if(!file.is_open()) {
-      throw new std::runtime_error("The file cannot be read.");
+      throw std::runtime_error("The file cannot be read: " + filePath);
     }
 
     file.seekg(0, std::ios::end);
@@ -17,9 +27,76 @@ namespace host {
 
     std::vector<char> data(fileSize, 0);
 
-    file.read(&data[0], fileSize);
+    file.read(data.data(), fileSize);
 
     return data;
   }
 
+#ifdef CHIP8_HAVE_POSIX_IO
+
+  // Roms are a few KB at most, where a plain read() beats mmap: mapping,
+  // faulting the page in and unmapping cost more than copying the bytes.
+  chip8::LoadStatus loadRomFile(chip8::VirtualMachine & vm, const std::string & filePath) {
+    const int descriptor = ::open(filePath.c_str(), O_RDONLY);
+
+    if(descriptor < 0) {
+      return chip8::LoadStatus::CannotOpen;
+    }
+
+    struct stat status;
+    auto result = chip8::LoadStatus::CannotRead;
+
+    if(::fstat(descriptor, &status) == 0 && S_ISREG(status.st_mode)) {
+      const auto size = static_cast<std::size_t>(status.st_size);
+      result = chip8::checkRomSize(vm, size);
+
+      if(result == chip8::LoadStatus::Loaded) {
+        auto destination = reinterpret_cast<char *>(&vm.memory[chip8::PROGRAM_START_ADDRESS]);
+        std::size_t done = 0;
+
+        while(done < size) {
+          const auto count = ::read(descriptor, destination + done, size - done);
+
+          if(count <= 0) {
+            result = chip8::LoadStatus::CannotRead;
+            break;
+          }
+
+          done += static_cast<std::size_t>(count);
+        }
+      }
+    }
+
+    ::close(descriptor);
+
+    return result;
+  }
+
+#else
+
+  chip8::LoadStatus loadRomFile(chip8::VirtualMachine & vm, const std::string & filePath) {
+    std::ifstream file{filePath, std::ios::binary | std::ios::ate};
+
+    if(!file.is_open()) {
+      return chip8::LoadStatus::CannotOpen;
+    }
+
+    const auto size = static_cast<std::size_t>(file.tellg());
+    const auto result = chip8::checkRomSize(vm, size);
+
+    if(result != chip8::LoadStatus::Loaded) {
+      return result;
+    }
+
+    file.seekg(0);
+
+    if(!file.read(reinterpret_cast<char *>(&vm.memory[chip8::PROGRAM_START_ADDRESS]), size)) {
+      return chip8::LoadStatus::CannotRead;
+    }
+
+    return result;
+  }
+
+#endif
+
 }
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "host/GatedTone.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace host {
+
+  GatedTone::GatedTone(int sampleRate, double frequency, std::int8_t amplitude, std::uint64_t maximumLead)
+    : events{}
+    , wave{sampleRate, frequency, amplitude}
+    , patternWave{sampleRate, amplitude}
+    , framesRendered{0}
+    , maximumLead{maximumLead}
+    , sounding{false}
+    , usePattern{false}
+  {
+
+  }
+
+  void GatedTone::apply(const SoundEvent & event) {
+    sounding = event.on;
+    usePattern = event.usePattern;
+
+    if(usePattern) {
+      patternWave.setPattern(event.pattern);
+      patternWave.setPitch(event.pitch);
+    }
+  }
+
+  void GatedTone::renderSpan(std::int8_t * stream, std::size_t frames, std::size_t channels) {
+    if(sounding && usePattern) {
+      patternWave.generate(stream, frames, channels);
+    } else if(sounding) {
+      wave.generate(stream, frames, channels);
+    } else {
+      std::memset(stream, 0, frames * channels);
+    }
+  }
+
+  void GatedTone::render(std::int8_t * stream, std::size_t frames, std::size_t channels) {
+    const auto end = framesRendered + frames;
+    std::size_t offset = 0;
+    SoundEvent event;
+
+    while(events.peek(event)) {
+      auto due = event.frame;
+
+      if(due > end + maximumLead) {
+        due = framesRendered + offset;
+      }
+
+      // An event due exactly at the end still applies, after the last frame:
+      // that's when the state it describes starts.
+      if(due > end) {
+        break;
+      }
+
+      // Render up to the event (late events apply immediately), then switch.
+      const auto eventOffset = static_cast<std::size_t>(std::max<std::uint64_t>(due, framesRendered + offset) - framesRendered);
+
+      renderSpan(stream + offset * channels, eventOffset - offset, channels);
+      offset = eventOffset;
+      apply(event);
+      events.pop(event);
+    }
+
+    renderSpan(stream + offset * channels, frames - offset, channels);
+    framesRendered = end;
+  }
+
+}
\ No newline at end of file
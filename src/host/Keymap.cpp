@@ -0,0 +1,112 @@
+#include "host/Keymap.hpp"
+#include "chip8/Constants.hpp"
+#include <istream>
+#include <sstream>
+#include <stdexcept>
+
+namespace host {
+
+  namespace {
+
+    const std::string GAMEPAD_PREFIX = "pad:";
+
+    std::string trim(const std::string & text) {
+      const auto first = text.find_first_not_of(" \t\r");
+
+      if(first == std::string::npos) {
+        return "";
+      }
+
+      return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+    }
+
+    std::runtime_error keymapError(std::size_t lineNumber, const std::string & message) {
+      return std::runtime_error("Keymap line " + std::to_string(lineNumber) + ": " + message);
+    }
+
+  }
+
+  Keymap::Keymap()
+    : scancodes{}
+    , buttons{}
+  {
+    scancodes.fill(UNBOUND_KEY);
+    buttons.fill(UNBOUND_KEY);
+  }
+
+  void Keymap::bindScancode(int scancode, chip8::Byte key) {
+    if(scancode < 0 || static_cast<std::size_t>(scancode) >= scancodes.size()) {
+      throw std::runtime_error("Scancode out of range: " + std::to_string(scancode));
+    }
+
+    scancodes[scancode] = static_cast<std::int8_t>(key);
+  }
+
+  void Keymap::bindButton(int button, chip8::Byte key) {
+    if(button < 0 || static_cast<std::size_t>(button) >= buttons.size()) {
+      throw std::runtime_error("Gamepad button out of range: " + std::to_string(button));
+    }
+
+    buttons[button] = static_cast<std::int8_t>(key);
+  }
+
+  void Keymap::load(std::istream & config, const BindingResolver & scancodeNamed, const BindingResolver & buttonNamed) {
+    std::string line;
+    std::size_t lineNumber = 0;
+
+    while(std::getline(config, line)) {
+      lineNumber++;
+      line = trim(line.substr(0, line.find('#')));
+
+      if(line.empty()) {
+        continue;
+      }
+
+      const auto equals = line.find('=');
+
+      if(equals == std::string::npos) {
+        throw keymapError(lineNumber, "expected KEY = BINDING[, BINDING...]");
+      }
+
+      const auto keyName = trim(line.substr(0, equals));
+      std::size_t parsed = 0;
+      int key = -1;
+
+      try {
+        key = std::stoi(keyName, &parsed, 16);
+      } catch(const std::exception &) {
+        parsed = 0;
+      }
+
+      if(parsed != keyName.size() || key < 0 || key >= static_cast<int>(chip8::KEY_COUNT)) {
+        throw keymapError(lineNumber, "'" + keyName + "' is not a CHIP-8 key (0-F)");
+      }
+
+      std::stringstream bindings{line.substr(equals + 1)};
+      std::string binding;
+
+      while(std::getline(bindings, binding, ',')) {
+        binding = trim(binding);
+
+        if(binding.compare(0, GAMEPAD_PREFIX.size(), GAMEPAD_PREFIX) == 0) {
+          const auto button = buttonNamed(binding.substr(GAMEPAD_PREFIX.size()));
+
+          if(button < 0) {
+            throw keymapError(lineNumber, "unknown gamepad button '" + binding + "'");
+          }
+
+          bindButton(button, static_cast<chip8::Byte>(key));
+        } else {
+          const auto scancode = scancodeNamed(binding);
+
+          if(scancode <= 0) {
+            throw keymapError(lineNumber, "unknown key '" + binding + "'");
+          }
+
+          bindScancode(scancode, static_cast<chip8::Byte>(key));
+        }
+      }
+    }
+  }
+
+}
\ No newline at end of file
@@ -3,11 +3,16 @@
 #include "chip8/Timers.hpp"
 #include "chip8/VirtualMachine.hpp"
 #include "chip8/Functions.hpp"
+#include "chip8/Profiler.hpp"
 #include "host/FileUtilities.hpp"
 #include "host/Application.hpp"
+#include "host/ToneGenerator.hpp"
+#include <fstream>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <random>
+#include <sstream>
 #include <vector>
 
 int main(int argc, char** argv) {
@@ -16,13 +21,59 @@ int main(int argc, char** argv) {
   const std::vector<std::string> allArgs(argv, argv + argc);
 
   std::string filePath{"brix.chip8"};
+  std::unique_ptr<Profile> profile;
+  bool xoChip = false;
+  std::uint16_t audioBufferFrames = host::DEFAULT_AUDIO_BUFFER_FRAMES;
+  std::string keymapPath;
 
-  if(allArgs.size() > 1) {
-    filePath = allArgs[1];
+  for(std::size_t i = 1; i < allArgs.size(); i++) {
+    if(allArgs[i] == "--profile") {
+      profile.reset(new Profile{});
+    } else if(allArgs[i] == "--xo-chip") {
+      xoChip = true;
+    } else if(allArgs[i] == "--audio-buffer" && i + 1 < allArgs.size()) {
+      audioBufferFrames = static_cast<std::uint16_t>(std::stoul(allArgs[++i]));
+    } else if(allArgs[i] == "--keymap" && i + 1 < allArgs.size()) {
+      keymapPath = allArgs[++i];
+    } else {
+      filePath = allArgs[i];
+    }
   }
 
   VirtualMachine vm;
-  host::Application app{vm};
+
+  if(xoChip) {
+    enableXoChip(vm);
+  }
+
+  const auto status = host::loadRomFile(vm, filePath);
+
+  if(status != LoadStatus::Loaded) {
+    std::cerr << filePath << ": " << describe(status) << std::endl;
+    return 1;
+  }
+
+  host::Keymap keymap;
+
+  try {
+    if(keymapPath.empty()) {
+      std::istringstream config{host::DEFAULT_KEYMAP};
+      keymap = host::readKeymap(config);
+    } else {
+      std::ifstream config{keymapPath};
+
+      if(!config.is_open()) {
+        throw std::runtime_error("Cannot read " + keymapPath);
+      }
+
+      keymap = host::readKeymap(config);
+    }
+  } catch(const std::exception & e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  host::Application app{vm, keymap, profile.get(), audioBufferFrames};
 
   std::random_device rd;
   std::mt19937 mt{rd()};
@@ -32,8 +83,11 @@ int main(int argc, char** argv) {
     return static_cast<Byte>(dist(mt));
   };
 
-  loadFontData(vm, chip8::FONT_DATA);
-  loadRomData(vm, host::readFileAsChar(filePath));
+  const auto result = app.run();
+
+  if(profile) {
+    printProfileReport(*profile, std::cout);
+  }
 
-  return app.run();
+  return result;
 }
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "host/MappedFile.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CHIP8_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+namespace host {
+
+#ifdef CHIP8_HAVE_MMAP
+
+  MappedFile::MappedFile(const std::string & path)
+    : data{nullptr}
+    , size{0}
+    , open{false}
+    , mapped{false}
+  {
+    const int descriptor = ::open(path.c_str(), O_RDONLY);
+
+    if(descriptor < 0) {
+      return;
+    }
+
+    struct stat status;
+
+    if(::fstat(descriptor, &status) == 0 && S_ISREG(status.st_mode)) {
+      size = static_cast<std::size_t>(status.st_size);
+
+      if(size == 0) {
+        open = true;
+      } else {
+        void * address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+        if(address != MAP_FAILED) {
+          data = static_cast<const char *>(address);
+          open = true;
+          mapped = true;
+        } else {
+          size = 0;
+        }
+      }
+    }
+
+    // The mapping stays valid after the descriptor is closed.
+    ::close(descriptor);
+  }
+
+  void MappedFile::close() {
+    if(mapped) {
+      ::munmap(const_cast<char *>(data), size);
+    }
+  }
+
+#else
+
+  MappedFile::MappedFile(const std::string & path)
+    : data{nullptr}
+    , size{0}
+    , open{false}
+    , mapped{false}
+  {
+    std::ifstream file{path, std::ios::binary | std::ios::ate};
+
+    if(!file.is_open()) {
+      return;
+    }
+
+    size = static_cast<std::size_t>(file.tellg());
+    file.seekg(0);
+
+    char * buffer = new char[size > 0 ? size : 1];
+
+    if(file.read(buffer, size)) {
+      data = buffer;
+      open = true;
+    } else {
+      delete[] buffer;
+      size = 0;
+    }
+  }
+
+  void MappedFile::close() {
+    delete[] data;
+  }
+
+#endif
+
+  MappedFile::~MappedFile() {
+    close();
+  }
+
+  MappedFile::MappedFile(MappedFile && other)
+    : data{other.data}
+    , size{other.size}
+    , open{other.open}
+    , mapped{other.mapped}
+  {
+    other.data = nullptr;
+    other.size = 0;
+    other.open = false;
+    other.mapped = false;
+  }
+
+  MappedFile & MappedFile::operator=(MappedFile && other) {
+    if(this != &other) {
+      close();
+      data = other.data;
+      size = other.size;
+      open = other.open;
+      mapped = other.mapped;
+      other.data = nullptr;
+      other.size = 0;
+      other.open = false;
+      other.mapped = false;
+    }
+
+    return *this;
+  }
+
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include "host/PatternWave.hpp"
+#include <cmath>
+
+namespace host {
+
+  PatternWave::PatternWave(int sampleRate, std::int8_t amplitude)
+    : increments{}
+    , levels{}
+    , amplitude{amplitude}
+    , phase{0}
+    , phaseIncrement{0}
+    , pitch{chip8::DEFAULT_PITCH}
+  {
+    levels.fill(static_cast<std::int8_t>(-amplitude));
+    setSampleRate(sampleRate);
+  }
+
+  void PatternWave::setSampleRate(int sampleRate) {
+    // The accumulator wraps at 2^32, one full pass over the pattern.
+    const double scale = 4294967296.0 / PATTERN_BITS / sampleRate;
+
+    for(std::size_t i = 0; i < PITCH_COUNT; i++) {
+      const auto bitsPerSecond = PATTERN_PLAYBACK_RATE * std::pow(2.0, (static_cast<double>(i) - 64.0) / 48.0);
+      increments[i] = static_cast<std::uint32_t>(std::llround(bitsPerSecond * scale));
+    }
+
+    phaseIncrement = increments[pitch];
+  }
+
+  void PatternWave::setPattern(const chip8::ByteArray<chip8::AUDIO_PATTERN_SIZE> & pattern) {
+    for(std::size_t bit = 0; bit < PATTERN_BITS; bit++) {
+      const bool set = (pattern[bit / 8] >> (7 - bit % 8)) & 1;
+      levels[bit] = set ? amplitude : static_cast<std::int8_t>(-amplitude);
+    }
+  }
+
+  void PatternWave::setPitch(chip8::Byte value) {
+    pitch = value;
+    phaseIncrement = increments[pitch];
+  }
+
+  void PatternWave::generate(std::int8_t * stream, std::size_t frames, std::size_t channels) {
+    for(std::size_t frame = 0; frame < frames; frame++) {
+      const auto sample = levels[phase >> PATTERN_BITS_SHIFT];
+
+      for(std::size_t channel = 0; channel < channels; channel++) {
+        *stream++ = sample;
+      }
+
+      phase += phaseIncrement;
+    }
+  }
+
+}
\ No newline at end of file
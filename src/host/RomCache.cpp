@@ -0,0 +1,123 @@
+#include "host/RomCache.hpp"
+#include "host/MappedFile.hpp"
+#include "chip8/Constants.hpp"
+#include <algorithm>
+
+namespace host {
+
+  // FNV-1a, as used for the headless runner's state digests.
+  std::uint64_t hashRom(const char * data, std::size_t size) {
+    std::uint64_t hash = 14695981039346656037ULL;
+
+    for(std::size_t i = 0; i < size; i++) {
+      hash ^= static_cast<unsigned char>(data[i]);
+      hash *= 1099511628211ULL;
+    }
+
+    return hash;
+  }
+
+  namespace {
+
+    // The cache doesn't know which mode a rom will run in, so it only turns
+    // away roms that fit neither; loadMemoryImage checks the VM's own size.
+    chip8::LoadStatus checkCachedRomSize(std::size_t size) {
+      if(size == 0) {
+        return chip8::LoadStatus::Empty;
+      }
+
+      if(size > chip8::XO_CHIP_RAM_SIZE - chip8::PROGRAM_START_ADDRESS) {
+        return chip8::LoadStatus::TooLarge;
+      }
+
+      return chip8::LoadStatus::Loaded;
+    }
+
+  }
+
+  RomCache::RomCache()
+    : mutex{}
+    , byPath{}
+    , byHash{}
+  {
+
+  }
+
+  RomCache & RomCache::shared() {
+    static RomCache cache;
+    return cache;
+  }
+
+  // Returns the cached image with these contents, adding one if needed.
+  // Callers hold the mutex.
+  RomImage RomCache::intern(const char * data, std::size_t size) {
+    const auto hash = hashRom(data, size);
+    const auto range = byHash.equal_range(hash);
+
+    for(auto entry = range.first; entry != range.second; ++entry) {
+      const auto & image = *entry->second;
+
+      if(image.size() == chip8::PROGRAM_START_ADDRESS + size
+          && std::equal(data, data + size, image.begin() + chip8::PROGRAM_START_ADDRESS,
+            [](char a, chip8::Byte b) { return static_cast<chip8::Byte>(a) == b; })) {
+        return entry->second;
+      }
+    }
+
+    const RomImage image = std::make_shared<const chip8::Memory>(chip8::buildMemoryImage(data, size));
+    byHash.emplace(hash, image);
+
+    return image;
+  }
+
+  chip8::LoadStatus RomCache::get(const std::string & filePath, RomImage & image) {
+    {
+      std::lock_guard<std::mutex> lock{mutex};
+      const auto found = byPath.find(filePath);
+
+      if(found != byPath.end()) {
+        image = found->second;
+        return chip8::LoadStatus::Loaded;
+      }
+    }
+
+    // Read outside the lock; if two threads race on a new path, both read
+    // it and intern hands them the same image.
+    const MappedFile file{filePath};
+
+    if(!file.isOpen()) {
+      return chip8::LoadStatus::CannotOpen;
+    }
+
+    const auto status = checkCachedRomSize(file.getSize());
+
+    if(status != chip8::LoadStatus::Loaded) {
+      return status;
+    }
+
+    std::lock_guard<std::mutex> lock{mutex};
+    image = intern(file.getData(), file.getSize());
+    byPath.emplace(filePath, image);
+
+    return chip8::LoadStatus::Loaded;
+  }
+
+  chip8::LoadStatus RomCache::get(const char * data, std::size_t size, RomImage & image) {
+    const auto status = checkCachedRomSize(size);
+
+    if(status != chip8::LoadStatus::Loaded) {
+      return status;
+    }
+
+    std::lock_guard<std::mutex> lock{mutex};
+    image = intern(data, size);
+
+    return chip8::LoadStatus::Loaded;
+  }
+
+  std::size_t RomCache::size() const {
+    std::lock_guard<std::mutex> lock{mutex};
+    return byHash.size();
+  }
+
+}
\ No newline at end of file
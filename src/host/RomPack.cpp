@@ -0,0 +1,115 @@
+#include "host/RomPack.hpp"
+#include "chip8/VirtualMachine.hpp"
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+
+namespace host {
+
+  namespace {
+
+    std::uint64_t readLittleEndian(const char * data, std::size_t bytes) {
+      std::uint64_t value = 0;
+
+      for(std::size_t i = bytes; i > 0; i--) {
+        value = (value << 8) | static_cast<unsigned char>(data[i - 1]);
+      }
+
+      return value;
+    }
+
+    void writeLittleEndian(std::ostream & out, std::uint64_t value, std::size_t bytes) {
+      char buffer[8];
+
+      for(std::size_t i = 0; i < bytes; i++) {
+        buffer[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+      }
+
+      out.write(buffer, bytes);
+    }
+
+  }
+
+  bool writeRomPack(std::ostream & out, const std::vector<RomSpan> & roms) {
+    out.write(ROM_PACK_MAGIC, sizeof(ROM_PACK_MAGIC));
+    writeLittleEndian(out, ROM_PACK_VERSION, 4);
+    writeLittleEndian(out, roms.size(), 4);
+    writeLittleEndian(out, 0, 4);
+
+    std::uint64_t offset = ROM_PACK_HEADER_SIZE + (roms.size() + 1) * ROM_PACK_OFFSET_SIZE;
+
+    for(const auto & rom : roms) {
+      writeLittleEndian(out, offset, ROM_PACK_OFFSET_SIZE);
+      offset += rom.size;
+    }
+
+    writeLittleEndian(out, offset, ROM_PACK_OFFSET_SIZE);
+
+    for(const auto & rom : roms) {
+      out.write(rom.data, rom.size);
+    }
+
+    return static_cast<bool>(out);
+  }
+
+  RomPack::RomPack(const std::string & filePath)
+    : file{filePath}
+    , romCount{0}
+  {
+    if(!file.isOpen()) {
+      throw std::runtime_error("The rom pack cannot be read: " + filePath);
+    }
+
+    const auto data = file.getData();
+    const auto fileSize = file.getSize();
+
+    if(fileSize < ROM_PACK_HEADER_SIZE
+        || std::memcmp(data, ROM_PACK_MAGIC, sizeof(ROM_PACK_MAGIC)) != 0) {
+      throw std::runtime_error("Not a rom pack: " + filePath);
+    }
+
+    if(readLittleEndian(data + 4, 4) != ROM_PACK_VERSION) {
+      throw std::runtime_error("Unsupported rom pack version: " + filePath);
+    }
+
+    romCount = static_cast<std::size_t>(readLittleEndian(data + 8, 4));
+
+    if((fileSize - ROM_PACK_HEADER_SIZE) / ROM_PACK_OFFSET_SIZE < romCount + 1) {
+      throw std::runtime_error("Truncated rom pack offset table: " + filePath);
+    }
+
+    // Checking every offset here is what lets getRom() trust them.
+    std::uint64_t previous = ROM_PACK_HEADER_SIZE + (romCount + 1) * ROM_PACK_OFFSET_SIZE;
+
+    for(std::size_t i = 0; i <= romCount; i++) {
+      const auto offset = getOffset(i);
+
+      if(offset < previous || offset > fileSize) {
+        throw std::runtime_error("Corrupt rom pack offset table: " + filePath);
+      }
+
+      previous = offset;
+    }
+  }
+
+  std::uint64_t RomPack::getOffset(std::size_t index) const {
+    return readLittleEndian(file.getData() + ROM_PACK_HEADER_SIZE + index * ROM_PACK_OFFSET_SIZE, ROM_PACK_OFFSET_SIZE);
+  }
+
+  RomSpan RomPack::getRom(std::size_t index) const {
+    if(index >= romCount) {
+      throw std::runtime_error("No rom " + std::to_string(index) + " in a pack of " + std::to_string(romCount));
+    }
+
+    const auto begin = getOffset(index);
+    const auto end = getOffset(index + 1);
+
+    return RomSpan{ file.getData() + begin, static_cast<std::size_t>(end - begin) };
+  }
+
+  chip8::LoadStatus RomPack::loadRom(chip8::VirtualMachine & vm, std::size_t index) const {
+    const auto rom = getRom(index);
+    return chip8::loadRomData(vm, rom.data, rom.size);
+  }
+
+}
\ No newline at end of file
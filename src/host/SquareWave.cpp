@@ -0,0 +1,38 @@
+#include "host/SquareWave.hpp"
+#include <cmath>
+
+namespace host {
+
+  SquareWave::SquareWave(int sampleRate, double frequency, std::int8_t amplitude)
+    : table{}
+    , phase{0}
+    , phaseIncrement{0}
+  {
+    // High for the first half of the period, low for the second.
+    for(std::size_t i = 0; i < WAVE_TABLE_SIZE; i++) {
+      table[i] = i < WAVE_TABLE_SIZE / 2 ? amplitude : static_cast<std::int8_t>(-amplitude);
+    }
+
+    setFrequency(sampleRate, frequency);
+  }
+
+  void SquareWave::setFrequency(int sampleRate, double frequency) {
+    // The accumulator wraps at 2^32, one full period.
+    phaseIncrement = static_cast<std::uint32_t>(std::llround(frequency / sampleRate * 4294967296.0));
+  }
+
+  void SquareWave::generate(std::int8_t * stream, std::size_t frames, std::size_t channels) {
+    const auto shift = 32 - WAVE_TABLE_BITS;
+
+    for(std::size_t frame = 0; frame < frames; frame++) {
+      const auto sample = table[phase >> shift];
+
+      for(std::size_t channel = 0; channel < channels; channel++) {
+        *stream++ = sample;
+      }
+
+      phase += phaseIncrement;
+    }
+  }
+
+}
\ No newline at end of file
@@ -1,37 +1,42 @@
 #include "host/ToneGenerator.hpp"
-#define _USE_MATH_DEFINES
-#include <cmath>
 #include <iostream>
 
 namespace host {
   void ToneGenerator::generateTone(void * userData, std::uint8_t * stream, int length) {
-    static double angle = 0.0;
+    auto & generator = *static_cast<ToneGenerator *>(userData);
+    const std::size_t channels = generator.obtained.channels;
 
-    for(int i = 0; i < length; i++) {
-      int8_t sample = std::sin(angle) >= 0 ? 1 : -1;
-      *stream++ = 5 * sample;
-      angle += 2 * M_PI / 800;
-    }
+    generator.tone.render(reinterpret_cast<std::int8_t *>(stream), length / channels, channels);
+    generator.framesRendered.store(generator.tone.getFramesRendered(), std::memory_order_release);
   }
 
-  ToneGenerator::ToneGenerator()
+  ToneGenerator::ToneGenerator(std::uint16_t bufferFrames)
     : desired{}
     , obtained{}
     , device{}
-    , active{false}
+    , tone{AUDIO_SAMPLE_RATE, TONE_FREQUENCY, TONE_AMPLITUDE, 2u * bufferFrames}
+    , framesRendered{0}
+    , anchorFrame{0}
+    , anchorTime{Clock::now()}
   {
     SDL_zero(desired);
-    desired.freq = 48000;
+    desired.freq = AUDIO_SAMPLE_RATE;
     desired.format = AUDIO_S8; // samples are int8_t
     desired.channels = 2;
-    desired.samples = 4096;
+    desired.samples = bufferFrames;
     desired.callback = ToneGenerator::generateTone;
+    desired.userdata = this;
 
-    device = SDL_OpenAudioDevice(nullptr, 0, &desired, &obtained, SDL_AUDIO_ALLOW_FORMAT_CHANGE);
+    // SDL converts from AUDIO_S8 if the device wants another format; a
+    // different rate is handled by retuning the wave.
+    device = SDL_OpenAudioDevice(nullptr, 0, &desired, &obtained, SDL_AUDIO_ALLOW_FREQUENCY_CHANGE);
 
     if(device == 0) {
       std::cout << "Unable to open audio device. SDL_Error: " << SDL_GetError() << std::endl;
     } else {
+      tone.setSampleRate(obtained.freq, TONE_FREQUENCY);
+      anchorTime = Clock::now();
+      SDL_PauseAudioDevice(device, UNPAUSE_AUDIO);
     }
   }
 
@@ -39,17 +44,28 @@ namespace host {
     SDL_CloseAudioDevice(device);
   }
 
-  void ToneGenerator::activate() {
-    if(!active) {
-      active = true;
-      SDL_PauseAudioDevice(device, UNPAUSE_AUDIO);
+  // Estimates which frame the callback will be rendering "now", one buffer
+  // ahead of what it has already rendered. The anchor moves every time a
+  // callback finishes, so the estimate can't drift from the device clock.
+  std::uint64_t ToneGenerator::currentFrame() {
+    const auto rendered = framesRendered.load(std::memory_order_acquire);
+    const auto now = Clock::now();
+
+    if(rendered != anchorFrame) {
+      anchorFrame = rendered;
+      anchorTime = now;
     }
+
+    const auto elapsed = std::chrono::duration<double>(now - anchorTime).count();
+
+    return anchorFrame + static_cast<std::uint64_t>(elapsed * obtained.freq) + obtained.samples;
   }
 
-  void ToneGenerator::deactivate() {
-    if(active) {
-      active = false;
-      SDL_PauseAudioDevice(device, PAUSE_AUDIO);
+  void ToneGenerator::queue(const SoundEvent & event, std::uint64_t) {
+    if(device != 0) {
+      SoundEvent timed = event;
+      timed.frame = currentFrame();
+      tone.push(timed);
     }
   }
 }
\ No newline at end of file
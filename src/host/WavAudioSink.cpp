@@ -0,0 +1,106 @@
+#include "host/WavAudioSink.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace host {
+
+  namespace {
+
+    const std::uint32_t WAV_HEADER_SIZE = 44;
+
+    void writeLittleEndian(std::ofstream & file, std::uint32_t value, std::size_t bytes) {
+      for(std::size_t i = 0; i < bytes; i++) {
+        file.put(static_cast<char>((value >> (i * 8)) & 0xFF));
+      }
+    }
+
+  }
+
+  WavAudioSink::WavAudioSink(const std::string & path, std::uint64_t cyclesPerSecond, int sampleRate)
+    : file{path, std::ios::binary}
+    , tone{sampleRate, TONE_FREQUENCY, TONE_AMPLITUDE, 0}
+    , chunk{}
+    , sampleRate{sampleRate}
+    , cyclesPerSecond{cyclesPerSecond}
+    , framesWritten{0}
+  {
+    if(!file.is_open()) {
+      throw std::runtime_error("Cannot write " + path);
+    }
+
+    writeHeader();
+  }
+
+  WavAudioSink::~WavAudioSink() {
+    writeHeader();
+  }
+
+  std::uint64_t WavAudioSink::frameAt(std::uint64_t cycle) const {
+    return cycle * sampleRate / cyclesPerSecond;
+  }
+
+  // Always renders at least once, so events due right now are applied even
+  // when there are no frames to write.
+  void WavAudioSink::renderTo(std::uint64_t frame) {
+    frame = std::max(frame, framesWritten);
+
+    do {
+      const auto frames = static_cast<std::size_t>(std::min<std::uint64_t>(frame - framesWritten, chunk.size()));
+
+      tone.render(chunk.data(), frames, 1);
+
+      // 8-bit WAV samples are unsigned, centred on 128.
+      for(std::size_t i = 0; i < frames; i++) {
+        chunk[i] ^= static_cast<std::int8_t>(0x80);
+      }
+
+      file.write(reinterpret_cast<const char *>(chunk.data()), frames);
+
+      framesWritten += frames;
+    } while(framesWritten < frame);
+  }
+
+  // RIFF header for 8-bit mono PCM, sized for what's been written so far.
+  void WavAudioSink::writeHeader() {
+    const auto dataSize = static_cast<std::uint32_t>(framesWritten);
+    const auto position = file.tellp();
+
+    file.seekp(0);
+    file.write("RIFF", 4);
+    writeLittleEndian(file, WAV_HEADER_SIZE - 8 + dataSize, 4);
+    file.write("WAVEfmt ", 8);
+    writeLittleEndian(file, 16, 4);         // fmt chunk size
+    writeLittleEndian(file, 1, 2);          // PCM
+    writeLittleEndian(file, 1, 2);          // mono
+    writeLittleEndian(file, sampleRate, 4);
+    writeLittleEndian(file, sampleRate, 4); // bytes per second
+    writeLittleEndian(file, 1, 2);          // bytes per frame
+    writeLittleEndian(file, 8, 2);          // bits per sample
+    file.write("data", 4);
+    writeLittleEndian(file, dataSize, 4);
+
+    if(position > std::ofstream::pos_type(WAV_HEADER_SIZE)) {
+      file.seekp(position);
+    }
+  }
+
+  // Everything before the change is rendered first, so the event is always
+  // due at the start of the next render and the queue never backs up.
+  void WavAudioSink::queue(const SoundEvent & event, std::uint64_t cycle) {
+    const auto frame = frameAt(cycle);
+    SoundEvent timed = event;
+
+    renderTo(frame);
+    timed.frame = frame;
+    tone.push(timed);
+  }
+
+  bool WavAudioSink::finish(std::uint64_t cycle) {
+    renderTo(frameAt(cycle));
+    writeHeader();
+    file.flush();
+
+    return static_cast<bool>(file);
+  }
+
+}
\ No newline at end of file
@@ -0,0 +1,11 @@
+; The skip splits the F155 into a block of its own, so the store that
+; rewrites "LD V2, 5" into "LD V2, 7" is the last instruction of its
+; block. The interpreter ends with V2 = 7.
+        LD I, target
+        LD V0, 0x62
+        LD V1, 0x07
+        SE V1, 0
+        LD [I], V1
+        LD V3, 0
+target: LD V2, 5
+done:   JP done
@@ -0,0 +1,174 @@
+#include "catch.hpp"
+#include "chip8/Assembler.hpp"
+#include "chip8/Decoder.hpp"
+#include "chip8/Disassembler.hpp"
+#include "chip8/Functions.hpp"
+#include "chip8/VirtualMachine.hpp"
+#include "host/FileUtilities.hpp"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+  std::vector<chip8::Byte> bytes(std::initializer_list<chip8::Byte> list) {
+    return std::vector<chip8::Byte>(list);
+  }
+
+}
+
+TEST_CASE( "Assembler", "source to rom bytes" ) {
+  SECTION( "instructions assemble in the disassembler's syntax" ) {
+    REQUIRE( (chip8::assemble("CLS") == bytes({ 0x00, 0xE0 })) );
+    REQUIRE( (chip8::assemble("ld ve, 0x05") == bytes({ 0x6E, 0x05 })) );
+    REQUIRE( (chip8::assemble("LD V1, V2") == bytes({ 0x81, 0x20 })) );
+    REQUIRE( (chip8::assemble("LD V1, DT") == bytes({ 0xF1, 0x07 })) );
+    REQUIRE( (chip8::assemble("LD I, 0x2F0") == bytes({ 0xA2, 0xF0 })) );
+    REQUIRE( (chip8::assemble("LD [I], VA") == bytes({ 0xFA, 0x55 })) );
+    REQUIRE( (chip8::assemble("LD HF, V8") == bytes({ 0xF8, 0x30 })) );
+    REQUIRE( (chip8::assemble("SE V3, V4") == bytes({ 0x53, 0x40 })) );
+    REQUIRE( (chip8::assemble("SE V3, 4") == bytes({ 0x33, 0x04 })) );
+    REQUIRE( (chip8::assemble("ADD I, V2") == bytes({ 0xF2, 0x1E })) );
+    REQUIRE( (chip8::assemble("ADD V2, -1") == bytes({ 0x72, 0xFF })) );
+    REQUIRE( (chip8::assemble("JP V0, 0x400") == bytes({ 0xB4, 0x00 })) );
+    REQUIRE( (chip8::assemble("DRW V1, V2, 15") == bytes({ 0xD1, 0x2F })) );
+  }
+
+  SECTION( "SUPER-CHIP and XO-CHIP instructions assemble too" ) {
+    REQUIRE( (chip8::assemble("SCD 4\nSCR\nSCL\nLOW\nHIGH") == bytes({ 0x00, 0xC4, 0x00, 0xFB, 0x00, 0xFC, 0x00, 0xFE, 0x00, 0xFF })) );
+    REQUIRE( (chip8::assemble("SAVE V1, V3\nLOAD V3, V1") == bytes({ 0x51, 0x32, 0x53, 0x13 })) );
+    REQUIRE( (chip8::assemble("PLANE 3\nAUDIO\nPITCH V6") == bytes({ 0xF3, 0x01, 0xF0, 0x02, 0xF6, 0x3A })) );
+    REQUIRE( (chip8::assemble("LD I, LONG 0x1234") == bytes({ 0xF0, 0x00, 0x12, 0x34 })) );
+  }
+
+  SECTION( "labels can be used before and after they're defined" ) {
+    const auto rom = chip8::assemble(
+      "start:  CALL sub      ; 0x200\n"
+      "        JP start      ; 0x202\n"
+      "sub:    LD I, LONG far\n"
+      "        RET           ; 0x208\n"
+      "far:\n"
+    );
+
+    REQUIRE( (rom == bytes({ 0x22, 0x04, 0x12, 0x00, 0xF0, 0x00, 0x02, 0x0A, 0x00, 0xEE })) );
+  }
+
+  SECTION( "constants, $ and arithmetic" ) {
+    const auto rom = chip8::assemble(
+      "HEIGHT EQU 5\n"
+      "TOP    EQU HEIGHT + 0x10 - 1\n"
+      "       LD V1, TOP\n"
+      "       DRW V0, V1, sprite.end - sprite\n"
+      "       JP $\n"
+      "sprite: DB 0xF0, 0b10010000, 0x90\n"
+      "sprite.end:\n"
+    );
+
+    REQUIRE( (rom == bytes({ 0x61, 0x14, 0xD0, 0x13, 0x12, 0x04, 0xF0, 0x90, 0x90 })) );
+  }
+
+  SECTION( "data directives" ) {
+    REQUIRE( (chip8::assemble("DB \"Hi; there\", 0") == bytes({ 'H', 'i', ';', ' ', 't', 'h', 'e', 'r', 'e', 0 })) );
+    REQUIRE( (chip8::assemble("DW 0x1234, end\nend:") == bytes({ 0x12, 0x34, 0x02, 0x04 })) );
+    REQUIRE( (chip8::assemble("CLS\nORG 0x206\nRET") == bytes({ 0x00, 0xE0, 0, 0, 0, 0, 0x00, 0xEE })) );
+    REQUIRE( (chip8::assemble("JP here\nhere:", 0x600) == bytes({ 0x16, 0x02 })) );
+    REQUIRE( chip8::assemble("; nothing but a comment\n\n").empty() );
+  }
+
+  SECTION( "errors name the line" ) {
+    const std::vector<std::string> sources {
+      "CLS\nFOO V1",
+      "CLS\nLD V1, V2, V3",
+      "CLS\nJP nowhere",
+      "CLS\nJP 0x1000",
+      "CLS\nLD V1, 256",
+      "CLS\nDRW V1, V2, 16",
+      "a: CLS\na: CLS",
+      "CLS\nV1: CLS",
+      "CLS\nORG 0x100",
+      "CLS\nDB",
+      "CLS\nLD V1, 0xZZ"
+    };
+
+    for(const auto & source : sources) {
+      try {
+        chip8::assemble(source);
+        FAIL( "assembled: " << source );
+      } catch(const std::runtime_error & e) {
+        REQUIRE( std::string{e.what()}.find("line 2: ") == 0 );
+      }
+    }
+
+    REQUIRE_THROWS_AS(chip8::assemble("ORG 0xFFFE\nLD I, LONG 0"), const std::runtime_error &);
+  }
+
+  SECTION( "everything the disassembler writes assembles back to the same text" ) {
+    // In slices of 4096, since all 65536 don't fit in the address space.
+    for(unsigned int first = 0; first <= 0xFFFF; first += 0x1000) {
+      std::string source;
+
+      for(unsigned int instruction = first; instruction < first + 0x1000; instruction++) {
+        source += chip8::disassemble(instruction, 0xBEEF).c_str();
+        source += '\n';
+      }
+
+      const auto rom = chip8::assemble(source, 0);
+      std::size_t offset = 0;
+
+      for(unsigned int instruction = first; instruction < first + 0x1000; instruction++) {
+        const auto longAddress = offset + 4 <= rom.size() ? (rom[offset + 2] << 8) | rom[offset + 3] : 0;
+        const auto expected = chip8::disassemble(instruction, 0xBEEF);
+        const auto actual = chip8::disassemble((rom[offset] << 8) | rom[offset + 1], longAddress);
+
+        if(std::string{expected.c_str()} != actual.c_str()) {
+          FAIL( expected.c_str() << " assembled to " << actual.c_str() );
+        }
+
+        offset += chip8::classify(instruction) == chip8::OpcodeFamily::setIToLongAddress ? 4 : 2;
+      }
+
+      REQUIRE( offset == rom.size() );
+    }
+  }
+
+  SECTION( "the bundled roms survive disassembleSource and assemble byte for byte" ) {
+    for(const auto name : { "breakout.chip8", "brix.chip8", "invaders.chip8", "pong.chip8" }) {
+      const auto file = host::readFileAsChar(std::string{CHIP8_ASSETS_DIR} + "/" + name);
+      const std::vector<chip8::Byte> rom(file.begin(), file.end());
+      std::string source;
+
+      chip8::disassembleSource(rom.data(), rom.size(), chip8::PROGRAM_START_ADDRESS, source);
+
+      REQUIRE( (chip8::assemble(source) == rom) );
+    }
+  }
+
+  SECTION( "an assembled rom runs" ) {
+    const auto rom = chip8::assemble(
+      "       LD V0, 0\n"
+      "       LD V1, 10\n"
+      "loop:  ADD V0, V1   ; V0 = 10 + 9 + ... + 1\n"
+      "       ADD V1, -1\n"
+      "       SE V1, 0\n"
+      "       JP loop\n"
+      "       LD I, digits\n"
+      "       LD B, V0\n"
+      "done:  JP done\n"
+      "digits:\n"
+    );
+
+    chip8::VirtualMachine vm;
+    REQUIRE( chip8::loadRomData(vm, reinterpret_cast<const char *>(rom.data()), rom.size()) == chip8::LoadStatus::Loaded );
+    chip8::reset(vm);
+
+    for(std::size_t i = 0; i < 100; i++) {
+      chip8::cycle(vm);
+    }
+
+    REQUIRE( vm.registers[0] == 55 );
+    REQUIRE( vm.memory[0x212] == 0 );
+    REQUIRE( vm.memory[0x213] == 5 );
+    REQUIRE( vm.memory[0x214] == 5 );
+    REQUIRE( vm.programCounter == 0x210 );
+  }
+}
\ No newline at end of file
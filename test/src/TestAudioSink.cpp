@@ -0,0 +1,151 @@
+#include "catch.hpp"
+#include "chip8/Functions.hpp"
+#include "chip8/VirtualMachine.hpp"
+#include "host/WavAudioSink.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+  const std::string WAV_PATH = "chip8-test-audio.wav";
+  const std::size_t WAV_HEADER_SIZE = 44;
+
+  std::vector<std::uint8_t> readWav() {
+    std::ifstream file{WAV_PATH, std::ios::binary};
+
+    return std::vector<std::uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+
+  std::uint32_t readLittleEndian(const std::vector<std::uint8_t> & bytes, std::size_t offset, std::size_t size) {
+    std::uint32_t value = 0;
+
+    for(std::size_t i = 0; i < size; i++) {
+      value |= static_cast<std::uint32_t>(bytes[offset + i]) << (i * 8);
+    }
+
+    return value;
+  }
+
+  // Frame-th sample, as a signed value around zero.
+  int sampleAt(const std::vector<std::uint8_t> & wav, std::size_t frame) {
+    return static_cast<int>(wav[WAV_HEADER_SIZE + frame]) - 128;
+  }
+
+}
+
+TEST_CASE( "WAV audio sink", "offline buzzer rendering" ) {
+
+  SECTION( "writes a valid 8-bit mono header sized to the rendered frames" ) {
+    {
+      // 480 cycles per second at 48000Hz: 100 frames per cycle.
+      host::WavAudioSink sink{WAV_PATH, 480};
+      REQUIRE( sink.finish(30) );
+      REQUIRE( sink.getFramesWritten() == 3000 );
+    }
+
+    const auto wav = readWav();
+
+    REQUIRE( wav.size() == WAV_HEADER_SIZE + 3000 );
+    REQUIRE( std::string(wav.begin(), wav.begin() + 4) == "RIFF" );
+    REQUIRE( readLittleEndian(wav, 4, 4) == 36 + 3000 );
+    REQUIRE( std::string(wav.begin() + 8, wav.begin() + 16) == "WAVEfmt " );
+    REQUIRE( readLittleEndian(wav, 20, 2) == 1 );
+    REQUIRE( readLittleEndian(wav, 22, 2) == 1 );
+    REQUIRE( readLittleEndian(wav, 24, 4) == 48000 );
+    REQUIRE( readLittleEndian(wav, 34, 2) == 8 );
+    REQUIRE( std::string(wav.begin() + 36, wav.begin() + 40) == "data" );
+    REQUIRE( readLittleEndian(wav, 40, 4) == 3000 );
+    REQUIRE( sampleAt(wav, 0) == 0 );
+  }
+
+  SECTION( "the tone starts and stops on the frames matching the cycles" ) {
+    {
+      host::WavAudioSink sink{WAV_PATH, 480};
+      sink.setSounding(true, 10);
+      sink.setSounding(false, 20);
+      REQUIRE( sink.finish(30) );
+    }
+
+    const auto wav = readWav();
+
+    REQUIRE( sampleAt(wav, 999) == 0 );
+    REQUIRE( sampleAt(wav, 1000) == host::TONE_AMPLITUDE );
+    REQUIRE( sampleAt(wav, 1999) != 0 );
+    REQUIRE( sampleAt(wav, 2000) == 0 );
+    REQUIRE( sampleAt(wav, 2999) == 0 );
+  }
+
+  SECTION( "repeated and simultaneous changes render as the final state" ) {
+    {
+      host::WavAudioSink sink{WAV_PATH, 48000};
+      sink.setSounding(true, 5);
+      sink.setSounding(true, 6);
+
+      // At 48000 cycles per second, one cycle per frame: many changes on a
+      // single frame must not back up the event queue.
+      for(std::uint64_t i = 0; i < 1000; i++) {
+        sink.setSounding(i % 2 == 0, 10);
+      }
+
+      REQUIRE( sink.finish(20) );
+    }
+
+    const auto wav = readWav();
+
+    REQUIRE( sampleAt(wav, 4) == 0 );
+    REQUIRE( sampleAt(wav, 5) != 0 );
+    REQUIRE( sampleAt(wav, 9) != 0 );
+    REQUIRE( sampleAt(wav, 10) == 0 );
+    REQUIRE( sampleAt(wav, 19) == 0 );
+  }
+
+  SECTION( "updateAudio follows the VM's sound timer and XO-CHIP pattern" ) {
+    chip8::VirtualMachine vm;
+    chip8::enableXoChip(vm);
+    vm.audioPattern.fill(0xFF);
+
+    {
+      host::WavAudioSink sink{WAV_PATH, 480};
+      host::updateAudio(sink, vm, true, 0);
+      vm.timers.sound = 1;
+      host::updateAudio(sink, vm, true, 5);
+      vm.timers.sound = 0;
+      host::updateAudio(sink, vm, true, 8);
+      REQUIRE( sink.finish(10) );
+    }
+
+    const auto wav = readWav();
+
+    REQUIRE( sampleAt(wav, 499) == 0 );
+
+    // An all-ones pattern is a constant high level, unlike the square wave.
+    for(std::size_t frame = 500; frame < 800; frame++) {
+      REQUIRE( sampleAt(wav, frame) == host::TONE_AMPLITUDE );
+    }
+
+    REQUIRE( sampleAt(wav, 800) == 0 );
+  }
+
+  SECTION( "sound stays off when disabled" ) {
+    chip8::VirtualMachine vm;
+    vm.timers.sound = 10;
+
+    {
+      host::WavAudioSink sink{WAV_PATH, 480};
+      host::updateAudio(sink, vm, false, 0);
+      REQUIRE( sink.finish(10) );
+    }
+
+    const auto wav = readWav();
+
+    for(std::size_t frame = 0; frame < 1000; frame++) {
+      REQUIRE( sampleAt(wav, frame) == 0 );
+    }
+  }
+
+  std::remove(WAV_PATH.c_str());
+}
\ No newline at end of file
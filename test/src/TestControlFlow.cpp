@@ -0,0 +1,126 @@
+#include "catch.hpp"
+#include "chip8/ControlFlow.hpp"
+#include "chip8/Functions.hpp"
+#include "chip8/VirtualMachine.hpp"
+#include <vector>
+
+namespace {
+
+  chip8::Memory memoryWith(const std::vector<chip8::Instruction> & program) {
+    chip8::Memory memory(chip8::RAM_SIZE, 0);
+    std::size_t address = chip8::PROGRAM_START_ADDRESS;
+
+    for(const auto instruction : program) {
+      memory[address++] = static_cast<chip8::Byte>(instruction >> 8);
+      memory[address++] = static_cast<chip8::Byte>(instruction & 0xFF);
+    }
+
+    return memory;
+  }
+
+  bool hasEdge(const chip8::BasicBlock & block, chip8::Address target, chip8::EdgeKind kind) {
+    for(const auto & edge : block.successors) {
+      if(edge.target == target && edge.kind == kind) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+}
+
+TEST_CASE( "Control flow graphs", "basic blocks, edges and findings" ) {
+  SECTION( "a straight line ending in a jump is one block" ) {
+    const auto graph = chip8::buildControlFlowGraph(memoryWith({ 0x6001, 0x7001, 0x1200 }));
+
+    REQUIRE( graph.blocks.size() == 1 );
+
+    const auto & block = graph.blocks.at(0x200);
+
+    REQUIRE( block.end == 0x206 );
+    REQUIRE( block.instructionCount == 3 );
+    REQUIRE( block.successors.size() == 1 );
+    REQUIRE( hasEdge(block, 0x200, chip8::EdgeKind::Jump) );
+  }
+
+  SECTION( "a jump into the middle of a run splits it" ) {
+    //   0x200: 6001  0x202: 7001  0x204: 1202
+    const auto graph = chip8::buildControlFlowGraph(memoryWith({ 0x6001, 0x7001, 0x1202 }));
+
+    REQUIRE( graph.blocks.size() == 2 );
+    REQUIRE( graph.blocks.at(0x200).end == 0x202 );
+    REQUIRE( hasEdge(graph.blocks.at(0x200), 0x202, chip8::EdgeKind::Fallthrough) );
+    REQUIRE( graph.blocks.at(0x202).instructionCount == 2 );
+  }
+
+  SECTION( "skips branch over the next instruction" ) {
+    //   0x200: 3000  0x202: 1200  0x204: 1204
+    const auto graph = chip8::buildControlFlowGraph(memoryWith({ 0x3000, 0x1200, 0x1204 }));
+
+    REQUIRE( graph.blocks.size() == 3 );
+    REQUIRE( hasEdge(graph.blocks.at(0x200), 0x202, chip8::EdgeKind::Fallthrough) );
+    REQUIRE( hasEdge(graph.blocks.at(0x200), 0x204, chip8::EdgeKind::Branch) );
+  }
+
+  SECTION( "skips step over F000 NNNN in XO-CHIP mode" ) {
+    //   0x200: 3000  0x202: F000 0300  0x206: 1206
+    const auto memory = memoryWith({ 0x3000, 0xF000, 0x0300, 0x1206 });
+    const auto graph = chip8::buildControlFlowGraph(memory, chip8::PROGRAM_START_ADDRESS, true);
+
+    REQUIRE( hasEdge(graph.blocks.at(0x200), 0x206, chip8::EdgeKind::Branch) );
+    REQUIRE( graph.blocks.at(0x202).end == 0x206 );
+  }
+
+  SECTION( "calls edge to the subroutine and fall through to the return address" ) {
+    //   0x200: 2206  0x202: 1202  ...  0x206: 00EE
+    const auto graph = chip8::buildControlFlowGraph(memoryWith({ 0x2206, 0x1202, 0x0000, 0x00EE }));
+
+    REQUIRE( graph.subroutines.count(0x206) == 1 );
+    REQUIRE( hasEdge(graph.blocks.at(0x200), 0x206, chip8::EdgeKind::Call) );
+    REQUIRE( hasEdge(graph.blocks.at(0x200), 0x202, chip8::EdgeKind::Fallthrough) );
+    REQUIRE( graph.blocks.at(0x206).endsInReturn );
+    REQUIRE( graph.blocks.at(0x206).successors.empty() );
+    REQUIRE( graph.blocks.count(0x204) == 0 );
+  }
+
+  SECTION( "computed jumps end the walk and are flagged" ) {
+    const auto graph = chip8::buildControlFlowGraph(memoryWith({ 0x6000, 0xB300 }));
+
+    REQUIRE( graph.blocks.size() == 1 );
+    REQUIRE( graph.blocks.at(0x200).endsInComputedJump );
+    REQUIRE( (graph.computedJumps == std::vector<chip8::Address>{ 0x202 }) );
+  }
+
+  SECTION( "stores are judged by where I points" ) {
+    //   0x200: A204  0x202: F055 (writes 0x204, which is code)
+    //   0x204: A300  0x206: F355 (writes data)
+    //   0x208: F01E  0x20A: F033 (I is no longer known)
+    //   0x20C: 120C
+    const auto graph = chip8::buildControlFlowGraph(memoryWith({ 0xA204, 0xF055, 0xA300, 0xF355, 0xF01E, 0xF033, 0x120C }));
+
+    REQUIRE( (graph.selfModifyingStores == std::vector<chip8::Address>{ 0x202 }) );
+    REQUIRE( (graph.unresolvedStores == std::vector<chip8::Address>{ 0x20A }) );
+    REQUIRE( graph.blocks.at(0x200).hasSelfModifyingStore );
+    REQUIRE( graph.blocks.at(0x200).hasUnresolvedStore );
+  }
+
+  SECTION( "every instruction the interpreter runs lies inside a block" ) {
+    // Counts V0 up to 5, then calls a subroutine and parks in a loop.
+    chip8::VirtualMachine vm;
+    chip8::loadRomData(vm, std::vector<char>{ 0x60, 0x00, 0x70, 0x01, 0x30, 0x05, 0x12, 0x02, 0x22, 0x0C, 0x12, 0x0A, 0x00, static_cast<char>(0xEE) });
+    chip8::reset(vm);
+
+    const auto graph = chip8::buildControlFlowGraph(chip8::Memory(vm.memory.begin(), vm.memory.end()));
+
+    for(int i = 0; i < 64; i++) {
+      const auto pc = vm.programCounter;
+      const auto block = graph.blocks.upper_bound(pc);
+
+      REQUIRE( block != graph.blocks.begin() );
+      REQUIRE( pc < std::prev(block)->second.end );
+
+      chip8::cycle(vm);
+    }
+  }
+}
\ No newline at end of file
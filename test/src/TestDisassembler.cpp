@@ -0,0 +1,177 @@
+#include "catch.hpp"
+#include "chip8/Decoder.hpp"
+#include "chip8/Disassembler.hpp"
+#include <bitset>
+#include <string>
+#include <vector>
+
+namespace {
+
+  std::string text(chip8::Instruction instruction, chip8::Instruction longAddress = 0) {
+    return chip8::disassemble(instruction, longAddress).c_str();
+  }
+
+  std::string listing(const std::vector<chip8::Byte> & bytes, chip8::Address origin = 0x200) {
+    std::string out;
+    chip8::disassemble(bytes.data(), bytes.size(), origin, out);
+    return out;
+  }
+
+}
+
+TEST_CASE( "Decoder", "the shared opcode table" ) {
+  SECTION( "every family's own pattern decodes to it" ) {
+    for(std::size_t i = 0; i + 1 < chip8::OPCODE_FAMILY_COUNT; i++) {
+      const auto family = static_cast<chip8::OpcodeFamily>(i);
+      const auto & info = chip8::getOpcodeInfo(family);
+
+      REQUIRE( chip8::classify(info.value) == family );
+    }
+  }
+
+  SECTION( "an instruction decodes to a family whose pattern it matches" ) {
+    for(unsigned int instruction = 0; instruction <= 0xFFFF; instruction++) {
+      const auto & info = chip8::getOpcodeInfo(chip8::classify(instruction));
+
+      if((instruction & info.mask) != info.value) {
+        FAIL( "0x" << std::hex << instruction << " decodes to " << info.name );
+      }
+    }
+  }
+
+  SECTION( "every instruction decodes to the narrowest pattern it matches" ) {
+    for(unsigned int instruction = 0; instruction <= 0xFFFF; instruction++) {
+      auto expected = chip8::OpcodeFamily::unknown;
+      int expectedBits = -1;
+
+      for(std::size_t i = 0; i + 1 < chip8::OPCODE_FAMILY_COUNT; i++) {
+        const auto & info = chip8::OPCODE_INFO[i];
+        const int bits = std::bitset<16>{info.mask}.count();
+
+        if((instruction & info.mask) == info.value && bits > expectedBits) {
+          expected = static_cast<chip8::OpcodeFamily>(i);
+          expectedBits = bits;
+        }
+      }
+
+      if(chip8::classify(instruction) != expected) {
+        FAIL( "0x" << std::hex << instruction << " decodes to " << chip8::getOpcodeFamilyName(chip8::classify(instruction)) );
+      }
+    }
+  }
+
+  SECTION( "instructions no handler accepts are unknown" ) {
+    REQUIRE( chip8::classify(0x8128) == chip8::OpcodeFamily::unknown );
+    REQUIRE( chip8::classify(0xE19F) == chip8::OpcodeFamily::unknown );
+    REQUIRE( chip8::classify(0xF100) == chip8::OpcodeFamily::unknown );
+    REQUIRE( chip8::classify(0xF102) == chip8::OpcodeFamily::unknown );
+    REQUIRE( chip8::classify(0xF0FF) == chip8::OpcodeFamily::unknown );
+  }
+}
+
+TEST_CASE( "Disassembler", "instruction text and listings" ) {
+  SECTION( "instructions are written in Cowgod's syntax" ) {
+    REQUIRE( text(0x00E0) == "CLS" );
+    REQUIRE( text(0x00EE) == "RET" );
+    REQUIRE( text(0x0123) == "SYS 0x123" );
+    REQUIRE( text(0x00C4) == "SCD 4" );
+    REQUIRE( text(0x00DF) == "SCU 15" );
+    REQUIRE( text(0x00FF) == "HIGH" );
+    REQUIRE( text(0x1ABC) == "JP 0xABC" );
+    REQUIRE( text(0x2300) == "CALL 0x300" );
+    REQUIRE( text(0x3A07) == "SE VA, 0x07" );
+    REQUIRE( text(0x4BFF) == "SNE VB, 0xFF" );
+    REQUIRE( text(0x5120) == "SE V1, V2" );
+    REQUIRE( text(0x5132) == "SAVE V1, V3" );
+    REQUIRE( text(0x5F03) == "LOAD VF, V0" );
+    REQUIRE( text(0x6E05) == "LD VE, 0x05" );
+    REQUIRE( text(0x7201) == "ADD V2, 0x01" );
+    REQUIRE( text(0x8214) == "ADD V2, V1" );
+    REQUIRE( text(0x8316) == "SHR V3, V1" );
+    REQUIRE( text(0x83CE) == "SHL V3, VC" );
+    REQUIRE( text(0x8457) == "SUBN V4, V5" );
+    REQUIRE( text(0xA2F0) == "LD I, 0x2F0" );
+    REQUIRE( text(0xB400) == "JP V0, 0x400" );
+    REQUIRE( text(0xC10F) == "RND V1, 0x0F" );
+    REQUIRE( text(0xD125) == "DRW V1, V2, 5" );
+    REQUIRE( text(0xD120) == "DRW V1, V2, 0" );
+    REQUIRE( text(0xE59E) == "SKP V5" );
+    REQUIRE( text(0xE5A1) == "SKNP V5" );
+    REQUIRE( text(0xF000, 0x1234) == "LD I, LONG 0x1234" );
+    REQUIRE( text(0xF301) == "PLANE 3" );
+    REQUIRE( text(0xF002) == "AUDIO" );
+    REQUIRE( text(0xF63A) == "PITCH V6" );
+    REQUIRE( text(0xF70A) == "LD V7, K" );
+    REQUIRE( text(0xF830) == "LD HF, V8" );
+    REQUIRE( text(0xF933) == "LD B, V9" );
+    REQUIRE( text(0xFA55) == "LD [I], VA" );
+    REQUIRE( text(0xFA65) == "LD VA, [I]" );
+  }
+
+  SECTION( "unknown instructions are written as data" ) {
+    REQUIRE( text(0x8128) == "DW 0x8128" );
+    REQUIRE( text(0xFFFF) == "DW 0xFFFF" );
+  }
+
+  SECTION( "every instruction fits in DISASSEMBLY_MAX_LENGTH" ) {
+    for(unsigned int instruction = 0; instruction <= 0xFFFF; instruction++) {
+      const auto disassembly = chip8::disassemble(instruction, 0xFFFF);
+
+      if(disassembly.length > chip8::DISASSEMBLY_MAX_LENGTH || disassembly.text[disassembly.length] != '\0') {
+        FAIL( "0x" << std::hex << instruction << " disassembles to " << disassembly.length << " characters" );
+      }
+    }
+  }
+
+  SECTION( "a listing has one line per instruction, with its address and bytes" ) {
+    const std::vector<chip8::Byte> bytes { 0x6E, 0x05, 0x00, 0xE0, 0x12, 0x00 };
+
+    REQUIRE( listing(bytes) ==
+      "0x200  6E05       LD VE, 0x05\n"
+      "0x202  00E0       CLS\n"
+      "0x204  1200       JP 0x200\n" );
+  }
+
+  SECTION( "F000 takes the word after it, and an odd last byte is listed alone" ) {
+    const std::vector<chip8::Byte> bytes { 0xF0, 0x00, 0x12, 0x34, 0xF0, 0x00, 0xAB };
+
+    REQUIRE( listing(bytes) ==
+      "0x200  F000 1234  LD I, LONG 0x1234\n"
+      "0x204  F000       LD I, LONG 0x0000\n"
+      "0x206  AB         DB 0xAB\n" );
+  }
+
+  SECTION( "addresses take four digits once the listing passes 0xFFF" ) {
+    const std::vector<chip8::Byte> bytes { 0x00, 0xEE, 0x00, 0xE0 };
+
+    REQUIRE( listing(bytes, 0xFFE) ==
+      "0x0FFE  00EE       RET\n"
+      "0x1000  00E0       CLS\n" );
+  }
+
+  SECTION( "a listing is appended to what the string already holds" ) {
+    std::string out = "; brix\n";
+    const std::vector<chip8::Byte> bytes { 0x00, 0xE0 };
+
+    chip8::disassemble(bytes.data(), bytes.size(), 0x200, out);
+
+    REQUIRE( out == "; brix\n0x200  00E0       CLS\n" );
+    REQUIRE( listing({}) == "" );
+  }
+
+  SECTION( "source leaves out the columns and keeps every bit" ) {
+    // 5121 reads as SE V1, V2 but that assembles to 5120, so it stays a word.
+    const std::vector<chip8::Byte> bytes { 0x6E, 0x05, 0x51, 0x21, 0xF0, 0x00, 0x12, 0x34, 0xF0, 0x00, 0xAB };
+    std::string out;
+
+    chip8::disassembleSource(bytes.data(), bytes.size(), 0x200, out);
+
+    REQUIRE( out ==
+      "ORG 0x200\n"
+      "LD VE, 0x05\n"
+      "DW 0x5121\n"
+      "LD I, LONG 0x1234\n"
+      "DW 0xF000\n"
+      "DB 0xAB\n" );
+  }
+}
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include "catch.hpp"
+#include "chip8/Functions.hpp"
+#include "chip8/Profiler.hpp"
+#include "chip8/VirtualMachine.hpp"
+#include "host/EmulationClock.hpp"
+#include <vector>
+
+namespace {
+
+  void loadProgram(chip8::VirtualMachine & vm, const std::vector<char> & program) {
+    chip8::loadRomData(vm, program);
+    chip8::reset(vm);
+  }
+
+}
+
+TEST_CASE( "Emulation clock", "cycle-accurate input scheduling" ) {
+  chip8::VirtualMachine vm;
+  host::EmulationClock clock;
+
+  SECTION( "one second of emulated time is 500 cycles and 60 timer updates" ) {
+    // 0x200: JP 0x200
+    loadProgram(vm, { 0x12, 0x00 });
+    vm.timers.delay = 100;
+
+    clock.advanceTo(host::CLOCK_TICKS_PER_SECOND, vm);
+
+    REQUIRE( clock.getCycles() == 500 );
+    REQUIRE( clock.getNow() == host::CLOCK_TICKS_PER_SECOND );
+    REQUIRE( vm.timers.delay == 40 );
+  }
+
+  SECTION( "catching up in uneven steps runs the same cycles" ) {
+    loadProgram(vm, { 0x12, 0x00 });
+
+    for(std::uint64_t target = 7; target < host::CLOCK_TICKS_PER_SECOND; target += 7) {
+      clock.advanceTo(target, vm);
+    }
+
+    clock.advanceTo(host::CLOCK_TICKS_PER_SECOND, vm);
+
+    REQUIRE( clock.getCycles() == 500 );
+  }
+
+  SECTION( "input applies on the tick it is stamped with" ) {
+    loadProgram(vm, { 0x12, 0x00 });
+    clock.queueInput(100, 0x5, true);
+    clock.queueInput(200, 0x5, false);
+
+    clock.advanceTo(100, vm);
+    REQUIRE_FALSE( vm.keyboard[0x5] );
+
+    clock.advanceTo(101, vm);
+    REQUIRE( vm.keyboard[0x5] );
+
+    clock.advanceTo(200, vm);
+    REQUIRE( vm.keyboard[0x5] );
+
+    clock.advanceTo(201, vm);
+    REQUIRE_FALSE( vm.keyboard[0x5] );
+    REQUIRE_FALSE( clock.hasPendingInput() );
+  }
+
+  SECTION( "a tap shorter than a cycle is still seen by one cycle" ) {
+    // 0x200: SKP V0      ; V0 = 0, so this checks key 0
+    // 0x202: JP 0x200
+    // 0x204: ADD V1, 1
+    // 0x206: JP 0x200
+    loadProgram(vm, { static_cast<char>(0xE0), static_cast<char>(0x9E), 0x12, 0x00, 0x71, 0x01, 0x12, 0x00 });
+
+    // SKP runs on the cycles at ticks 0, 12, 24...
+    clock.queueInput(12, 0x0, true);
+    clock.queueInput(12, 0x0, false);
+    clock.advanceTo(host::CLOCK_TICKS_PER_SECOND, vm);
+
+    REQUIRE( vm.registers[1] == 1 );
+    REQUIRE_FALSE( vm.keyboard[0x0] );
+  }
+
+  SECTION( "input stamped in the past applies on the next tick" ) {
+    loadProgram(vm, { 0x12, 0x00 });
+    clock.advanceTo(500, vm);
+    clock.queueInput(10, 0x3, true);
+    clock.advanceTo(501, vm);
+
+    REQUIRE( vm.keyboard[0x3] );
+  }
+
+  SECTION( "a keypress ends an Fx0A wait on its tick" ) {
+    // 0x200: LD V2, K
+    // 0x202: JP 0x202
+    loadProgram(vm, { static_cast<char>(0xF2), 0x0A, 0x12, 0x02 });
+    clock.queueInput(300, 0xB, true);
+
+    clock.advanceTo(300, vm);
+    REQUIRE( vm.awaitingKeypress );
+
+    clock.advanceTo(301, vm);
+    REQUIRE_FALSE( vm.awaitingKeypress );
+    REQUIRE( vm.registers[2] == 0xB );
+  }
+
+  SECTION( "waiting on Fx0A skips ahead with timers and cycle counts intact" ) {
+    loadProgram(vm, { static_cast<char>(0xF2), 0x0A, 0x12, 0x02 });
+    vm.timers.delay = 100;
+    vm.timers.sound = 30;
+
+    chip8::Profile profile;
+    clock.advanceTo(host::CLOCK_TICKS_PER_SECOND, vm, &profile);
+
+    REQUIRE( clock.getCycles() == 500 );
+    REQUIRE( profile.cycles == 500 );
+    REQUIRE( profile.keypressWaitCycles == 499 );
+    REQUIRE( vm.timers.delay == 40 );
+    REQUIRE( vm.timers.sound == 0 );
+    REQUIRE( vm.awaitingKeypress );
+  }
+
+  SECTION( "the next timer update is the next multiple of 50 ticks after now" ) {
+    loadProgram(vm, { 0x12, 0x00 });
+
+    REQUIRE( clock.getNextTimerUpdate() == host::CLOCK_TICKS_PER_TIMER_UPDATE );
+
+    clock.advanceTo(1, vm);
+    REQUIRE( clock.getNextTimerUpdate() == host::CLOCK_TICKS_PER_TIMER_UPDATE );
+
+    // Never now itself, or a host waiting for it would never sleep.
+    clock.advanceTo(host::CLOCK_TICKS_PER_TIMER_UPDATE, vm);
+    REQUIRE( clock.getNextTimerUpdate() == 2 * host::CLOCK_TICKS_PER_TIMER_UPDATE );
+  }
+}
\ No newline at end of file
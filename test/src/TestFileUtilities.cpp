@@ -0,0 +1,76 @@
+#include "catch.hpp"
+#include "chip8/Functions.hpp"
+#include "chip8/VirtualMachine.hpp"
+#include "host/FileUtilities.hpp"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+  const std::string ROM_PATH = "chip8-test-rom.chip8";
+
+  void writeRom(const std::vector<char> & data) {
+    std::ofstream file{ROM_PATH, std::ios::binary};
+    file.write(data.data(), data.size());
+  }
+
+}
+
+TEST_CASE( "Rom loading", "validated, status-returning rom loaders" ) {
+  chip8::VirtualMachine vm;
+
+  SECTION( "loadRomData copies the rom to the program start address" ) {
+    const std::vector<char> rom { 0x12, 0x34, static_cast<char>(0xAB) };
+
+    REQUIRE( chip8::loadRomData(vm, rom) == chip8::LoadStatus::Loaded );
+    REQUIRE( vm.memory[chip8::PROGRAM_START_ADDRESS] == 0x12 );
+    REQUIRE( vm.memory[chip8::PROGRAM_START_ADDRESS + 2] == 0xAB );
+  }
+
+  SECTION( "loadRomData rejects roms that don't fit and leaves memory alone" ) {
+    const std::vector<char> fits(chip8::RAM_SIZE - chip8::PROGRAM_START_ADDRESS, 0x11);
+    const std::vector<char> tooLarge(fits.size() + 1, 0x22);
+
+    REQUIRE( chip8::loadRomData(vm, tooLarge) == chip8::LoadStatus::TooLarge );
+    REQUIRE( vm.memory[chip8::PROGRAM_START_ADDRESS] == 0 );
+    REQUIRE( chip8::loadRomData(vm, fits) == chip8::LoadStatus::Loaded );
+    REQUIRE( vm.memory[chip8::RAM_SIZE - 1] == 0x11 );
+  }
+
+  SECTION( "XO-CHIP VMs take roms up to 64KB" ) {
+    const std::vector<char> rom(chip8::XO_CHIP_RAM_SIZE - chip8::PROGRAM_START_ADDRESS, 0x33);
+
+    REQUIRE( chip8::loadRomData(vm, rom) == chip8::LoadStatus::TooLarge );
+    chip8::enableXoChip(vm);
+    REQUIRE( chip8::loadRomData(vm, rom) == chip8::LoadStatus::Loaded );
+  }
+
+  SECTION( "loadRomData rejects empty roms" ) {
+    REQUIRE( chip8::loadRomData(vm, std::vector<char>{}) == chip8::LoadStatus::Empty );
+  }
+
+  SECTION( "loadRomFile loads a file byte for byte" ) {
+    // Includes a CR LF pair and a 0x1A, which text mode reads could alter.
+    writeRom({ 0x0D, 0x0A, 0x1A, 0x00, static_cast<char>(0xFF) });
+
+    REQUIRE( host::loadRomFile(vm, ROM_PATH) == chip8::LoadStatus::Loaded );
+    REQUIRE( vm.memory[chip8::PROGRAM_START_ADDRESS] == 0x0D );
+    REQUIRE( vm.memory[chip8::PROGRAM_START_ADDRESS + 1] == 0x0A );
+    REQUIRE( vm.memory[chip8::PROGRAM_START_ADDRESS + 2] == 0x1A );
+    REQUIRE( vm.memory[chip8::PROGRAM_START_ADDRESS + 4] == 0xFF );
+  }
+
+  SECTION( "loadRomFile reports missing, empty and oversized files" ) {
+    REQUIRE( host::loadRomFile(vm, "no-such-rom.chip8") == chip8::LoadStatus::CannotOpen );
+
+    writeRom({});
+    REQUIRE( host::loadRomFile(vm, ROM_PATH) == chip8::LoadStatus::Empty );
+
+    writeRom(std::vector<char>(chip8::RAM_SIZE, 0x12));
+    REQUIRE( host::loadRomFile(vm, ROM_PATH) == chip8::LoadStatus::TooLarge );
+  }
+
+  std::remove(ROM_PATH.c_str());
+}
\ No newline at end of file
@@ -115,7 +115,7 @@ TEST_CASE( "Basic VM functions", "fetch return value and side effects" ) {
     REQUIRE( vm.programCounter == (pc + 2) );
   }
 
-  SECTION( "cycle should decrement the delay and sound counters by 1 if they're non-zero" ) {
+  SECTION( "cycle followed by updateTimers should decrement the delay and sound counters by 1 if they're non-zero" ) {
     vm.memory[0] = 0x80; // set register 0 to itself
     vm.memory[1] = 0x00;
     vm.memory[2] = 0x10; // jump back to the beginning
@@ -127,13 +127,14 @@ TEST_CASE( "Basic VM functions", "fetch return value and side effects" ) {
     auto pc = vm.programCounter;
 
     chip8::cycle(vm);
+    chip8::updateTimers(vm);
 
     REQUIRE( vm.programCounter == (pc + 2) );
     REQUIRE( vm.timers.delay == 9 );
     REQUIRE( vm.timers.sound == 14 );
   }
 
-  SECTION( "cycle should not decrement the delay and sound counters by 1 if they're equal to zero" ) {
+  SECTION( "cycle followed by updateTimers should not decrement the delay and sound counters by 1 if they're equal to zero" ) {
     vm.memory[0] = 0x80; // set register 0 to itself
     vm.memory[1] = 0x00;
     vm.memory[2] = 0x10; // jump back to the beginning
@@ -143,6 +144,7 @@ TEST_CASE( "Basic VM functions", "fetch return value and side effects" ) {
     vm.timers.sound = 0;
 
     chip8::cycle(vm);
+    chip8::updateTimers(vm);
 
     REQUIRE( vm.timers.delay == 0 );
     REQUIRE( vm.timers.sound == 0 );
@@ -206,3 +208,168 @@ TEST_CASE( "Basic VM functions", "fetch return value and side effects" ) {
     REQUIRE( vm.keyboard[0x3] == 0 );
   }
 }
+
+
+TEST_CASE( "XO-CHIP mode", "memory size and instruction length" ) {
+  chip8::VirtualMachine vm;
+
+  REQUIRE( vm.xoChip == false );
+
+  SECTION( "enableXoChip grows memory to 64KB, keeping its contents" ) {
+    vm.memory[0x200] = 0x12;
+
+    chip8::enableXoChip(vm);
+
+    REQUIRE( vm.xoChip == true );
+    REQUIRE( vm.memory.size() == 65536 );
+    REQUIRE( vm.memory[0x200] == 0x12 );
+    REQUIRE( vm.memory[0xFFFF] == 0 );
+  }
+
+  SECTION( "a copied VM has its own memory in either mode" ) {
+    vm.memory[0x200] = 0x12;
+
+    chip8::VirtualMachine copy{vm};
+    copy.memory[0x200] = 0x34;
+
+    REQUIRE( copy.memory.data() != vm.memory.data() );
+    REQUIRE( vm.memory[0x200] == 0x12 );
+
+    chip8::enableXoChip(vm);
+    vm.memory[0xFFFF] = 0x56;
+    copy = vm;
+    copy.memory[0xFFFF] = 0x78;
+
+    REQUIRE( copy.memory.size() == 65536 );
+    REQUIRE( copy.memory[0x200] == 0x12 );
+    REQUIRE( vm.memory[0xFFFF] == 0x56 );
+  }
+
+  SECTION( "F000 NNNN loads a 16 bit address into I and is four bytes long" ) {
+    chip8::enableXoChip(vm);
+    vm.memory[0] = 0xF0;
+    vm.memory[1] = 0x00;
+    vm.memory[2] = 0xBE;
+    vm.memory[3] = 0xEF;
+
+    chip8::cycle(vm);
+
+    REQUIRE( vm.I == 0xBEEF );
+    REQUIRE( vm.programCounter == 4 );
+  }
+
+  SECTION( "skips step over a following F000 NNNN in XO-CHIP mode only" ) {
+    vm.memory[0] = 0x30; // skip if V0 == 0
+    vm.memory[1] = 0x00;
+    vm.memory[2] = 0xF0;
+    vm.memory[3] = 0x00;
+
+    chip8::cycle(vm);
+
+    REQUIRE( vm.programCounter == 4 );
+
+    chip8::enableXoChip(vm);
+    vm.programCounter = 0;
+
+    chip8::cycle(vm);
+
+    REQUIRE( vm.programCounter == 6 );
+  }
+}
+
+TEST_CASE( "Addresses past the end of memory", "I and the program counter wrap around" ) {
+  chip8::VirtualMachine vm;
+
+  SECTION( "stores and loads through I wrap in CHIP-8 mode" ) {
+    vm.registers[0] = 123;
+    vm.I = 0xFFF;
+
+    chip8::execute(vm, 0xF033);
+
+    REQUIRE( vm.memory[0xFFF] == 1 );
+    REQUIRE( vm.memory[0x000] == 2 );
+    REQUIRE( vm.memory[0x001] == 3 );
+
+    // FX1E can take I past 0xFFF; it wraps to the same 4KB.
+    vm.registers[1] = 0xAB;
+    vm.I = 0xFFFF;
+
+    chip8::execute(vm, 0xF155);
+
+    REQUIRE( vm.memory[0xFFF] == 123 );
+    REQUIRE( vm.memory[0x000] == 0xAB );
+  }
+
+  SECTION( "stores and loads through I wrap in XO-CHIP mode" ) {
+    chip8::enableXoChip(vm);
+    vm.registers[0] = 123;
+    vm.I = 0xFFFF;
+
+    chip8::execute(vm, 0xF033);
+
+    REQUIRE( vm.memory[0xFFFF] == 1 );
+    REQUIRE( vm.memory[0x0000] == 2 );
+    REQUIRE( vm.memory[0x0001] == 3 );
+
+    vm.registers[1] = 0x11;
+    vm.registers[2] = 0x22;
+    vm.I = 0xFFFE;
+
+    chip8::execute(vm, 0x5122);
+    chip8::execute(vm, 0xF265);
+
+    REQUIRE( vm.memory[0xFFFF] == 0x22 );
+    REQUIRE( vm.registers[0] == 0x11 );
+    REQUIRE( vm.registers[1] == 0x22 );
+    REQUIRE( vm.registers[2] == 0x02 );
+
+    vm.memory[0xFFFE] = 0x5A;
+    vm.I = 0xFFF8;
+
+    chip8::execute(vm, 0xF002);
+
+    REQUIRE( vm.audioPattern[6] == 0x5A );
+    REQUIRE( vm.audioPattern[8] == 0x02 );
+  }
+
+  SECTION( "sprites read past the end of memory wrap" ) {
+    chip8::enableXoChip(vm);
+    vm.memory[0xFFFF] = 0x80;
+    vm.memory[0x0000] = 0x80;
+    vm.I = 0xFFFF;
+
+    chip8::execute(vm, 0xD012);
+
+    REQUIRE( vm.graphics[0] == 0x8000000000000000 );
+    REQUIRE( vm.graphics[1] == 0x8000000000000000 );
+  }
+
+  SECTION( "fetch wraps the program counter in both modes" ) {
+    vm.memory[0xFFF] = 0x61;
+    vm.memory[0x000] = 0x42;
+    vm.programCounter = 0xFFF;
+
+    REQUIRE( chip8::fetch(vm) == 0x6142 );
+
+    chip8::enableXoChip(vm);
+    vm.memory[0xFFFE] = 0x62;
+    vm.memory[0xFFFF] = 0x07;
+    vm.programCounter = 0xFFFE;
+
+    chip8::cycle(vm);
+
+    REQUIRE( vm.registers[2] == 0x07 );
+    REQUIRE( vm.programCounter == 0x0000 );
+  }
+
+  SECTION( "a skip at the top of XO-CHIP memory looks past the end" ) {
+    chip8::enableXoChip(vm);
+    vm.memory[0xFFFF] = 0xF0;
+    vm.memory[0x0000] = 0x00;
+    vm.programCounter = 0xFFFF;
+
+    chip8::execute(vm, 0x3000);
+
+    REQUIRE( vm.programCounter == 0x0003 );
+  }
+}
\ No newline at end of file
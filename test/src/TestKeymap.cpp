@@ -0,0 +1,96 @@
+#include "catch.hpp"
+#include "host/Keymap.hpp"
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+  // Stand-ins for SDL's name lookups, using SDL's numbering for the names
+  // the tests need.
+  int scancodeNamed(const std::string & name) {
+    static const std::map<std::string, int> scancodes {
+      { "A", 4 }, { "Q", 20 }, { "V", 25 }, { "W", 26 },
+      { "1", 30 }, { "2", 31 }, { "3", 32 }, { "4", 33 },
+      { "C", 6 }, { "D", 7 }, { "E", 8 }, { "F", 9 }, { "R", 21 }, { "S", 22 },
+      { "X", 27 }, { "Z", 29 }, { "Keypad 8", 96 }
+    };
+    const auto found = scancodes.find(name);
+
+    return found == scancodes.end() ? 0 : found->second;
+  }
+
+  int buttonNamed(const std::string & name) {
+    static const std::map<std::string, int> buttons {
+      { "a", 0 }, { "b", 1 }, { "dpup", 11 }, { "dpdown", 12 }, { "dpleft", 13 }, { "dpright", 14 }
+    };
+    const auto found = buttons.find(name);
+
+    return found == buttons.end() ? -1 : found->second;
+  }
+
+  host::Keymap keymapFrom(const std::string & text) {
+    std::istringstream config{text};
+    host::Keymap keymap;
+
+    keymap.load(config, scancodeNamed, buttonNamed);
+
+    return keymap;
+  }
+
+}
+
+TEST_CASE( "Keymap", "table-driven key bindings" ) {
+
+  SECTION( "a new keymap binds nothing" ) {
+    host::Keymap keymap;
+
+    REQUIRE( keymap.keyForScancode(4) == host::UNBOUND_KEY );
+    REQUIRE( keymap.keyForButton(0) == host::UNBOUND_KEY );
+  }
+
+  SECTION( "the default keymap keeps the original layout" ) {
+    const auto keymap = keymapFrom(host::DEFAULT_KEYMAP);
+
+    REQUIRE( keymap.keyForScancode(scancodeNamed("1")) == 0x0 );
+    REQUIRE( keymap.keyForScancode(scancodeNamed("4")) == 0x3 );
+    REQUIRE( keymap.keyForScancode(scancodeNamed("Q")) == 0x4 );
+    REQUIRE( keymap.keyForScancode(scancodeNamed("A")) == 0x8 );
+    REQUIRE( keymap.keyForScancode(scancodeNamed("Z")) == 0xC );
+    REQUIRE( keymap.keyForScancode(scancodeNamed("V")) == 0xF );
+    REQUIRE( keymap.keyForButton(buttonNamed("dpup")) == 0x5 );
+    REQUIRE( keymap.keyForButton(buttonNamed("a")) == 0x6 );
+  }
+
+  SECTION( "one CHIP-8 key can have several bindings" ) {
+    const auto keymap = keymapFrom("5 = W, Keypad 8, pad:dpup\n");
+
+    REQUIRE( keymap.keyForScancode(26) == 0x5 );
+    REQUIRE( keymap.keyForScancode(96) == 0x5 );
+    REQUIRE( keymap.keyForButton(11) == 0x5 );
+    REQUIRE( keymap.keyForScancode(4) == host::UNBOUND_KEY );
+  }
+
+  SECTION( "comments, blank lines and spacing are ignored" ) {
+    const auto keymap = keymapFrom("# movement\n\n  a=A   # left\r\n");
+
+    REQUIRE( keymap.keyForScancode(4) == 0xA );
+  }
+
+  SECTION( "out of range lookups are unbound" ) {
+    host::Keymap keymap;
+
+    REQUIRE( keymap.keyForScancode(-1) == host::UNBOUND_KEY );
+    REQUIRE( keymap.keyForScancode(100000) == host::UNBOUND_KEY );
+    REQUIRE( keymap.keyForButton(64) == host::UNBOUND_KEY );
+  }
+
+  SECTION( "bad configs are rejected" ) {
+    REQUIRE_THROWS_AS( keymapFrom("5 W\n"), const std::runtime_error & );
+    REQUIRE_THROWS_AS( keymapFrom("G = W\n"), const std::runtime_error & );
+    REQUIRE_THROWS_AS( keymapFrom("10 = W\n"), const std::runtime_error & );
+    REQUIRE_THROWS_AS( keymapFrom("5 = Nonsense\n"), const std::runtime_error & );
+    REQUIRE_THROWS_AS( keymapFrom("5 = pad:nonsense\n"), const std::runtime_error & );
+  }
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "catch.hpp"
 #include "chip8/VirtualMachine.hpp"
 #include "chip8/Opcodes.hpp"
+#include <stdexcept>
 #include <utility>
 
 TEST_CASE( "VM opcode functions", "execution of opcodes" ) {
@@ -52,6 +53,20 @@ TEST_CASE( "VM opcode functions", "execution of opcodes" ) {
     REQUIRE( vm.stack.top() == 0x42 );
   }
 
+  SECTION( "ops::callSubroutine throws once the stack holds STACK_SIZE addresses" ) {
+    for(std::size_t i = 0; i < chip8::STACK_SIZE; i++) {
+      chip8::ops::callSubroutine(vm, 0x2200);
+    }
+
+    REQUIRE( vm.stack.size() == chip8::STACK_SIZE );
+    REQUIRE_THROWS_AS( chip8::ops::callSubroutine(vm, 0x2200), const std::runtime_error & );
+    REQUIRE( vm.stack.size() == chip8::STACK_SIZE );
+  }
+
+  SECTION( "ops::returnFromSubroutine throws when the stack is empty" ) {
+    REQUIRE_THROWS_AS( chip8::ops::returnFromSubroutine(vm, 0x00EE), const std::runtime_error & );
+  }
+
   SECTION( "ops::returnFromSubroutine changes the program counter, pops stack" ) {
     vm.stack.push(0x0867);
 
@@ -832,6 +847,21 @@ TEST_CASE( "VM opcode functions", "execution of opcodes" ) {
     REQUIRE( vm.I == 0x5 * 15 );
   }
 
+  SECTION( "ops::disambiguate0xF calls ops::setIToBigCharacter, sets I to the big digit after the small font" ) {
+    vm.registers[0x6] = 0x0;
+    chip8::ops::disambiguate0xF(vm, 0xF630);
+    REQUIRE( vm.I == 0x5 * 16 );
+
+    vm.registers[0x6] = 0x9;
+    chip8::ops::disambiguate0xF(vm, 0xF630);
+    REQUIRE( vm.I == 0x5 * 16 + 10 * 9 );
+    REQUIRE( vm.memory[vm.I] == chip8::BIG_FONT_DATA[10 * 9] );
+
+    vm.registers[0x6] = 0x1F;
+    chip8::ops::disambiguate0xF(vm, 0xF630);
+    REQUIRE( vm.I == 0x5 * 16 + 10 * 15 );
+  }
+
   SECTION( "ops::storeBcdOfVx stores the binary-coded decimal value of VX at I" ) {
     vm.I = 10;
     vm.registers[0xE] = 128;
@@ -1009,4 +1039,241 @@ TEST_CASE( "VM opcode functions", "execution of opcodes" ) {
     REQUIRE( vm.registers[0xE] == 56 );
     REQUIRE( vm.registers[0xF] == 1 );
   }
+}
+
+TEST_CASE( "SUPER-CHIP opcode functions", "high resolution mode and scrolling" ) {
+  chip8::VirtualMachine vm;
+
+  REQUIRE( vm.highResolution == false );
+
+  SECTION( "ops::disambiguate0x0 switches resolution on 00FF and 00FE, clearing the screen" ) {
+    vm.graphics[0] = 0xFF;
+
+    chip8::ops::disambiguate0x0(vm, 0x00FF);
+
+    REQUIRE( vm.highResolution == true );
+
+    vm.hiResGraphics[10][1] = 0xFF;
+
+    chip8::ops::disambiguate0x0(vm, 0x00FE);
+
+    REQUIRE( vm.highResolution == false );
+    REQUIRE( vm.graphics[0] == 0 );
+
+    chip8::ops::disambiguate0x0(vm, 0x00FF);
+
+    REQUIRE( vm.hiResGraphics[10][1] == 0 );
+  }
+
+  SECTION( "ops::clearScreen clears the high resolution buffer in high resolution" ) {
+    chip8::ops::enableHighResolution(vm, 0x00FF);
+    vm.hiResGraphics[0][0] = 0xFF;
+    vm.hiResGraphics[63][1] = 0x4;
+
+    chip8::ops::clearScreen(vm, 0x00E0);
+
+    REQUIRE( vm.hiResGraphics[0][0] == 0 );
+    REQUIRE( vm.hiResGraphics[63][1] == 0 );
+  }
+
+  SECTION( "ops::blit draws sprites across both words of a high resolution row" ) {
+    chip8::ops::enableHighResolution(vm, 0x00FF);
+    vm.memory[0] = 0b11110001;
+    vm.registers[0] = 60; // Straddles the middle of the row.
+    vm.registers[1] = 40;
+
+    chip8::ops::blit(vm, 0xD011);
+
+    REQUIRE( vm.hiResGraphics[40][0] == 0b0000000000000000000000000000000000000000000000000000000000001111 );
+    REQUIRE( vm.hiResGraphics[40][1] == 0b0001000000000000000000000000000000000000000000000000000000000000 );
+    REQUIRE( vm.graphics[8] == 0 );
+    REQUIRE( vm.registers[0xF] == 0 );
+  }
+
+  SECTION( "ops::blit wraps high resolution sprites horizontally and vertically" ) {
+    chip8::ops::enableHighResolution(vm, 0x00FF);
+    vm.memory[0] = 0b11000011;
+    vm.memory[1] = 0b10000001;
+    vm.registers[0] = 124;
+    vm.registers[1] = 63;
+
+    chip8::ops::blit(vm, 0xD012);
+
+    REQUIRE( vm.hiResGraphics[63][0] == 0b0011000000000000000000000000000000000000000000000000000000000000 );
+    REQUIRE( vm.hiResGraphics[63][1] == 0b0000000000000000000000000000000000000000000000000000000000001100 );
+    REQUIRE( vm.hiResGraphics[0][0] == 0b0001000000000000000000000000000000000000000000000000000000000000 );
+    REQUIRE( vm.hiResGraphics[0][1] == 0b0000000000000000000000000000000000000000000000000000000000001000 );
+  }
+
+  SECTION( "ops::blit draws 16x16 sprites for DXY0 in high resolution and sets VF on collision" ) {
+    chip8::ops::enableHighResolution(vm, 0x00FF);
+
+    for(std::size_t i = 0; i < 32; i++) {
+      vm.memory[0x300 + i] = 0xFF;
+    }
+
+    vm.I = 0x300;
+    vm.registers[0] = 8;
+    vm.registers[1] = 2;
+
+    chip8::ops::blit(vm, 0xD010);
+
+    REQUIRE( vm.hiResGraphics[1][0] == 0 );
+    REQUIRE( vm.hiResGraphics[2][0] == 0b0000000011111111111111110000000000000000000000000000000000000000 );
+    REQUIRE( vm.hiResGraphics[17][0] == 0b0000000011111111111111110000000000000000000000000000000000000000 );
+    REQUIRE( vm.hiResGraphics[18][0] == 0 );
+    REQUIRE( vm.registers[0xF] == 0 );
+
+    chip8::ops::blit(vm, 0xD010);
+
+    REQUIRE( vm.hiResGraphics[2][0] == 0 );
+    REQUIRE( vm.registers[0xF] == 1 );
+  }
+
+  SECTION( "ops::scrollDown moves rows down by N, clearing the rows at the top" ) {
+    vm.graphics[0] = 0xF0;
+    vm.graphics[30] = 0x0F;
+
+    chip8::ops::disambiguate0x0(vm, 0x00C1);
+
+    REQUIRE( vm.graphics[0] == 0 );
+    REQUIRE( vm.graphics[1] == 0xF0 );
+    REQUIRE( vm.graphics[31] == 0x0F );
+
+    chip8::ops::enableHighResolution(vm, 0x00FF);
+    vm.hiResGraphics[0] = { { 1, 2 } };
+    vm.hiResGraphics[60] = { { 3, 4 } };
+
+    chip8::ops::disambiguate0x0(vm, 0x00C3);
+
+    REQUIRE( vm.hiResGraphics[0][0] == 0 );
+    REQUIRE( vm.hiResGraphics[2][1] == 0 );
+    REQUIRE( vm.hiResGraphics[3][0] == 1 );
+    REQUIRE( vm.hiResGraphics[3][1] == 2 );
+    REQUIRE( vm.hiResGraphics[63][0] == 3 );
+    REQUIRE( vm.hiResGraphics[63][1] == 4 );
+  }
+
+  SECTION( "ops::scrollRight and ops::scrollLeft move pixels by 4, carrying between words" ) {
+    vm.graphics[5] = 0b1111000000000000000000000000000000000000000000000000000000001111;
+
+    chip8::ops::disambiguate0x0(vm, 0x00FB);
+
+    REQUIRE( vm.graphics[5] == 0b0000111100000000000000000000000000000000000000000000000000000000 );
+
+    chip8::ops::disambiguate0x0(vm, 0x00FC);
+
+    REQUIRE( vm.graphics[5] == 0b1111000000000000000000000000000000000000000000000000000000000000 );
+
+    chip8::ops::enableHighResolution(vm, 0x00FF);
+    vm.hiResGraphics[5][0] = 0b0000000000000000000000000000000000000000000000000000000000001111;
+    vm.hiResGraphics[5][1] = 0b1111000000000000000000000000000000000000000000000000000000001111;
+
+    chip8::ops::disambiguate0x0(vm, 0x00FB);
+
+    REQUIRE( vm.hiResGraphics[5][0] == 0b0000000000000000000000000000000000000000000000000000000000000000 );
+    REQUIRE( vm.hiResGraphics[5][1] == 0b1111111100000000000000000000000000000000000000000000000000000000 );
+
+    chip8::ops::disambiguate0x0(vm, 0x00FC);
+
+    REQUIRE( vm.hiResGraphics[5][0] == 0b0000000000000000000000000000000000000000000000000000000000001111 );
+    REQUIRE( vm.hiResGraphics[5][1] == 0b1111000000000000000000000000000000000000000000000000000000000000 );
+  }
+}
+
+TEST_CASE( "XO-CHIP opcode functions", "bit planes, register ranges and audio" ) {
+  chip8::VirtualMachine vm;
+
+  REQUIRE( vm.selectedPlanes == 1 );
+  REQUIRE( vm.pitch == 64 );
+
+  SECTION( "ops::storeVxToVy and ops::loadVxToVy copy an inclusive register range without changing I" ) {
+    vm.I = 0x300;
+    vm.registers[0x2] = 7;
+    vm.registers[0x3] = 8;
+    vm.registers[0x4] = 9;
+
+    chip8::ops::disambiguate0x5(vm, 0x5242);
+
+    REQUIRE( vm.memory[0x300] == 7 );
+    REQUIRE( vm.memory[0x301] == 8 );
+    REQUIRE( vm.memory[0x302] == 9 );
+    REQUIRE( vm.I == 0x300 );
+
+    chip8::ops::disambiguate0x5(vm, 0x5A83);
+
+    REQUIRE( vm.registers[0xA] == 7 );
+    REQUIRE( vm.registers[0x9] == 8 );
+    REQUIRE( vm.registers[0x8] == 9 );
+  }
+
+  SECTION( "ops::disambiguate0x5 still skips on 5XY0" ) {
+    vm.registers[0x1] = 3;
+    vm.registers[0x2] = 3;
+
+    chip8::ops::disambiguate0x5(vm, 0x5120);
+
+    REQUIRE( vm.programCounter == 2 );
+  }
+
+  SECTION( "ops::selectPlanes limits clearing and drawing to the selected planes" ) {
+    vm.graphics[0] = 0xFF;
+    vm.graphicsPlane2[0] = 0xFF;
+
+    chip8::ops::disambiguate0xF(vm, 0xF201);
+    chip8::ops::clearScreen(vm, 0x00E0);
+
+    REQUIRE( vm.selectedPlanes == 2 );
+    REQUIRE( vm.graphics[0] == 0xFF );
+    REQUIRE( vm.graphicsPlane2[0] == 0 );
+  }
+
+  SECTION( "ops::blit with both planes selected draws plane 2's sprite after plane 1's" ) {
+    vm.memory[0x300] = 0b11110000;
+    vm.memory[0x301] = 0b00001111;
+    vm.I = 0x300;
+
+    chip8::ops::selectPlanes(vm, 0xF301);
+    chip8::ops::blit(vm, 0xD011);
+
+    REQUIRE( vm.graphics[0] == 0b1111000000000000000000000000000000000000000000000000000000000000 );
+    REQUIRE( vm.graphicsPlane2[0] == 0b0000111100000000000000000000000000000000000000000000000000000000 );
+    REQUIRE( vm.registers[0xF] == 0 );
+
+    vm.memory[0x300] = 0;
+
+    chip8::ops::blit(vm, 0xD011);
+
+    REQUIRE( vm.graphicsPlane2[0] == 0 );
+    REQUIRE( vm.registers[0xF] == 1 );
+  }
+
+  SECTION( "ops::scrollRight moves the high resolution rows of both planes" ) {
+    chip8::ops::enableHighResolution(vm, 0x00FF);
+    chip8::ops::selectPlanes(vm, 0xF301);
+    vm.hiResGraphics[0][0] = 0xF;
+    vm.hiResGraphicsPlane2[0][0] = 0xF0;
+
+    chip8::ops::scrollRight(vm, 0x00FB);
+
+    REQUIRE( vm.hiResGraphics[0][0] == 0 );
+    REQUIRE( vm.hiResGraphics[0][1] == 0xF000000000000000 );
+    REQUIRE( vm.hiResGraphicsPlane2[0][0] == 0xF );
+  }
+
+  SECTION( "ops::loadAudioPattern copies 16 bytes at I and ops::setPitch sets the pitch from VX" ) {
+    for(std::size_t i = 0; i < 16; i++) {
+      vm.memory[0x400 + i] = static_cast<chip8::Byte>(i * 3);
+    }
+
+    vm.I = 0x400;
+    vm.registers[0x5] = 112;
+
+    chip8::ops::disambiguate0xF(vm, 0xF002);
+    chip8::ops::disambiguate0xF(vm, 0xF53A);
+
+    REQUIRE( vm.audioPattern[0] == 0 );
+    REQUIRE( vm.audioPattern[15] == 45 );
+    REQUIRE( vm.pitch == 112 );
+  }
 }
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "catch.hpp"
+#include "host/GatedTone.hpp"
+#include "host/PatternWave.hpp"
+#include <cstdint>
+#include <vector>
+
+TEST_CASE( "XO-CHIP pattern playback", "resampled 1-bit audio patterns" ) {
+  chip8::ByteArray<chip8::AUDIO_PATTERN_SIZE> pattern{};
+
+  SECTION( "the default pitch plays 4000 bits per second" ) {
+    // 48000 / 4000 = 12 frames per bit, so the four set bits of 0xF0 last 48
+    // frames. The phase increment is rounded, so the edges themselves may
+    // land a frame late.
+    host::PatternWave wave{48000, 5};
+    std::vector<std::int8_t> samples(128 * 12);
+
+    pattern[0] = 0xF0;
+    wave.setPattern(pattern);
+    wave.generate(samples.data(), samples.size(), 1);
+
+    REQUIRE( samples[0] == 5 );
+    REQUIRE( samples[46] == 5 );
+    REQUIRE( samples[50] == -5 );
+    REQUIRE( samples[samples.size() - 2] == -5 );
+  }
+
+  SECTION( "the pattern loops after 128 bits" ) {
+    host::PatternWave wave{48000, 5};
+    std::vector<std::int8_t> samples(128 * 12 * 2);
+
+    pattern[15] = 0x01;
+    wave.setPattern(pattern);
+    wave.generate(samples.data(), samples.size(), 1);
+
+    REQUIRE( samples[127 * 12 - 2] == -5 );
+    REQUIRE( samples[127 * 12 + 6] == 5 );
+    REQUIRE( samples[128 * 12 + 6] == -5 );
+    REQUIRE( samples[255 * 12 + 6] == 5 );
+  }
+
+  SECTION( "every 48 steps of pitch doubles the playback rate" ) {
+    host::PatternWave wave{48000, 5};
+    const auto base = wave.getPhaseIncrement();
+
+    wave.setPitch(chip8::DEFAULT_PITCH + 48);
+    REQUIRE( wave.getPhaseIncrement() >= 2 * base - 1 );
+    REQUIRE( wave.getPhaseIncrement() <= 2 * base + 1 );
+
+    wave.setPitch(chip8::DEFAULT_PITCH - 48);
+    REQUIRE( wave.getPhaseIncrement() >= base / 2 - 1 );
+    REQUIRE( wave.getPhaseIncrement() <= base / 2 + 1 );
+  }
+
+  SECTION( "the pitch table follows the sample rate" ) {
+    host::PatternWave wave{48000, 5};
+    std::vector<std::int8_t> samples(64);
+
+    // 24000 / 8000 = 3 frames per bit at pitch 112.
+    wave.setSampleRate(24000);
+    wave.setPitch(112);
+    pattern[0] = 0xA0;
+    wave.setPattern(pattern);
+    wave.generate(samples.data(), samples.size(), 1);
+
+    REQUIRE( samples[1] == 5 );
+    REQUIRE( samples[4] == -5 );
+    REQUIRE( samples[7] == 5 );
+    REQUIRE( samples[10] == -5 );
+  }
+
+  SECTION( "generate writes the same sample to every channel of a frame" ) {
+    host::PatternWave wave{48000, 5};
+    std::vector<std::int8_t> samples(256 * 2);
+
+    pattern[0] = 0xCC;
+    wave.setPattern(pattern);
+    wave.generate(samples.data(), 256, 2);
+
+    for(std::size_t frame = 0; frame < 256; frame++) {
+      REQUIRE( samples[frame * 2] == samples[frame * 2 + 1] );
+    }
+  }
+
+  SECTION( "a gated tone switches to the pattern on the event's frame" ) {
+    host::GatedTone tone{48000, 120.0, 5, 1024};
+    std::vector<std::int8_t> samples(256);
+    host::SoundEvent event{};
+
+    pattern.fill(0xFF);
+    event.frame = 100;
+    event.on = true;
+    event.usePattern = true;
+    event.pitch = chip8::DEFAULT_PITCH;
+    event.pattern = pattern;
+
+    tone.push(event);
+    tone.render(samples.data(), samples.size(), 1);
+
+    REQUIRE( tone.isPlayingPattern() );
+    REQUIRE( samples[99] == 0 );
+
+    for(std::size_t frame = 100; frame < samples.size(); frame++) {
+      REQUIRE( samples[frame] == 5 );
+    }
+  }
+}
\ No newline at end of file
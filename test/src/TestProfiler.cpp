@@ -0,0 +1,119 @@
+#include "catch.hpp"
+#include "chip8/VirtualMachine.hpp"
+#include "chip8/Functions.hpp"
+#include "chip8/Profiler.hpp"
+#include <sstream>
+#include <string>
+
+TEST_CASE( "Opcode classification", "mapping instructions to ops:: handlers" ) {
+
+  SECTION( "classify distinguishes the 0x0 instructions" ) {
+    REQUIRE( chip8::classify(0x00E0) == chip8::OpcodeFamily::clearScreen );
+    REQUIRE( chip8::classify(0x00EE) == chip8::OpcodeFamily::returnFromSubroutine );
+    REQUIRE( chip8::classify(0x00C4) == chip8::OpcodeFamily::scrollDown );
+    REQUIRE( chip8::classify(0x00FB) == chip8::OpcodeFamily::scrollRight );
+    REQUIRE( chip8::classify(0x00FF) == chip8::OpcodeFamily::enableHighResolution );
+    REQUIRE( chip8::classify(0x0123) == chip8::OpcodeFamily::callProgramAtAddress );
+  }
+
+  SECTION( "classify distinguishes the 0x8 instructions by their last nibble" ) {
+    REQUIRE( chip8::classify(0x8120) == chip8::OpcodeFamily::setVxToVy );
+    REQUIRE( chip8::classify(0x8124) == chip8::OpcodeFamily::addVxVyUpdateCarry );
+    REQUIRE( chip8::classify(0x812E) == chip8::OpcodeFamily::leftshiftVx );
+    REQUIRE( chip8::classify(0x812F) == chip8::OpcodeFamily::unknown );
+  }
+
+  SECTION( "classify distinguishes the 0xE and 0xF instructions by their low byte" ) {
+    REQUIRE( chip8::classify(0xE19E) == chip8::OpcodeFamily::skipIfKeyIsPressed );
+    REQUIRE( chip8::classify(0xE1A1) == chip8::OpcodeFamily::skipIfKeyIsNotPressed );
+    REQUIRE( chip8::classify(0xE1FF) == chip8::OpcodeFamily::unknown );
+    REQUIRE( chip8::classify(0xF10A) == chip8::OpcodeFamily::waitForKeyPress );
+    REQUIRE( chip8::classify(0xF133) == chip8::OpcodeFamily::storeBcdOfVx );
+    REQUIRE( chip8::classify(0xF165) == chip8::OpcodeFamily::loadV0ToVx );
+  }
+
+  SECTION( "getOpcodeFamilyName returns the name of the handler" ) {
+    REQUIRE( std::string{chip8::getOpcodeFamilyName(chip8::OpcodeFamily::blit)} == "blit" );
+    REQUIRE( std::string{chip8::getOpcodeFamilyName(chip8::OpcodeFamily::unknown)} == "unknown" );
+  }
+}
+
+TEST_CASE( "Profiled execution", "counting executed instructions" ) {
+  chip8::VirtualMachine vm;
+  chip8::Profile profile;
+
+  vm.memory[0x200] = 0x60; // V0 = 0x01
+  vm.memory[0x201] = 0x01;
+  vm.memory[0x202] = 0x70; // V0 += 0x01
+  vm.memory[0x203] = 0x01;
+  vm.memory[0x204] = 0x12; // jump back to 0x202
+  vm.memory[0x205] = 0x02;
+
+  chip8::reset(vm);
+
+  SECTION( "cycle counts instructions per family and per address" ) {
+    for(int i = 0; i < 7; i++) {
+      chip8::cycle(vm, profile);
+    }
+
+    REQUIRE( profile.cycles == 7 );
+    REQUIRE( profile.keypressWaitCycles == 0 );
+    REQUIRE( profile.addressCounts[0x200] == 1 );
+    REQUIRE( profile.addressCounts[0x202] == 3 );
+    REQUIRE( profile.addressCounts[0x204] == 3 );
+    REQUIRE( profile.opcodeCounts[static_cast<std::size_t>(chip8::OpcodeFamily::setVx)] == 1 );
+    REQUIRE( profile.opcodeCounts[static_cast<std::size_t>(chip8::OpcodeFamily::addToVx)] == 3 );
+    REQUIRE( profile.opcodeCounts[static_cast<std::size_t>(chip8::OpcodeFamily::jump)] == 3 );
+    REQUIRE( vm.registers[0] == 4 );
+  }
+
+  SECTION( "cycle counts cycles spent waiting for a keypress" ) {
+    vm.awaitingKeypress = true;
+
+    chip8::cycle(vm, profile);
+    chip8::cycle(vm, profile);
+
+    REQUIRE( profile.cycles == 2 );
+    REQUIRE( profile.keypressWaitCycles == 2 );
+    REQUIRE( profile.addressCounts.empty() );
+    REQUIRE( vm.programCounter == 0x200 );
+  }
+
+  SECTION( "the address histogram covers the VM's memory, however large" ) {
+    chip8::cycle(vm, profile);
+
+    REQUIRE( profile.addressCounts.size() == chip8::RAM_SIZE );
+
+    chip8::enableXoChip(vm);
+    vm.memory[0xFFF0] = 0x12; // jump back to 0x202
+    vm.memory[0xFFF1] = 0x02;
+    vm.programCounter = 0xFFF0;
+    chip8::cycle(vm, profile);
+
+    REQUIRE( profile.addressCounts.size() == chip8::XO_CHIP_RAM_SIZE );
+    REQUIRE( profile.addressCounts[0x200] == 1 );
+    REQUIRE( profile.addressCounts[0xFFF0] == 1 );
+
+    // Every address takes four digits once one of them needs it.
+    std::ostringstream out;
+    chip8::printProfileReport(profile, out);
+
+    REQUIRE( out.str().find("0x0200") != std::string::npos );
+    REQUIRE( out.str().find("0xfff0") != std::string::npos );
+  }
+
+  SECTION( "printProfileReport lists the hottest families and addresses first" ) {
+    for(int i = 0; i < 7; i++) {
+      chip8::cycle(vm, profile);
+    }
+
+    std::ostringstream out;
+    chip8::printProfileReport(profile, out);
+
+    const auto report = out.str();
+
+    REQUIRE( report.find("instructions executed: 7") != std::string::npos );
+    REQUIRE( report.find("addToVx") < report.find("setVx ") );
+    REQUIRE( report.find("0x202") < report.find("0x200") );
+  }
+}
\ No newline at end of file
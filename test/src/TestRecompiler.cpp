@@ -0,0 +1,210 @@
+#include "catch.hpp"
+#include "chip8/ControlFlow.hpp"
+#include "chip8/Functions.hpp"
+#include "chip8/Recompiler.hpp"
+#include "chip8/VirtualMachine.hpp"
+#include "host/FileUtilities.hpp"
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Generated from the bundled roms by chip8-recompile at build time.
+extern const chip8::RecompiledRom RECOMPILED_BRIX;
+extern const chip8::RecompiledRom RECOMPILED_PONG;
+extern const chip8::RecompiledRom RECOMPILED_STORE_OVER_CODE;
+
+namespace {
+
+  void loadRom(chip8::VirtualMachine & vm, const std::string & name) {
+    REQUIRE( host::loadRomFile(vm, std::string{CHIP8_ASSETS_DIR} + "/" + name) == chip8::LoadStatus::Loaded );
+    chip8::reset(vm);
+  }
+
+  void requireSameState(const chip8::VirtualMachine & a, const chip8::VirtualMachine & b) {
+    REQUIRE( (a.registers == b.registers) );
+    REQUIRE( a.programCounter == b.programCounter );
+    REQUIRE( a.I == b.I );
+    REQUIRE( a.timers.delay == b.timers.delay );
+    REQUIRE( a.timers.sound == b.timers.sound );
+    REQUIRE( a.awaitingKeypress == b.awaitingKeypress );
+    REQUIRE( a.stack.size() == b.stack.size() );
+    REQUIRE( (a.memory == b.memory) );
+    REQUIRE( (a.graphics == b.graphics) );
+  }
+
+  // Runs the rom in two VMs, one with cycle() and one with the recompiled
+  // blocks, in uneven slices with keys and timers in between, and checks
+  // they stay identical.
+  void requireMatchesInterpreter(const chip8::RecompiledRom & rom, const std::string & name) {
+    chip8::VirtualMachine interpreted;
+    chip8::VirtualMachine recompiled;
+
+    loadRom(interpreted, name);
+    loadRom(recompiled, name);
+
+    chip8::RecompiledRunner runner{rom, recompiled};
+
+    REQUIRE( runner.isUsingBlocks() );
+
+    chip8::Byte key = 0;
+
+    for(std::size_t slice = 0; slice < 4000; slice++) {
+      const std::size_t cycles = 1 + (slice * 7) % 13;
+
+      for(std::size_t i = 0; i < cycles; i++) {
+        chip8::cycle(interpreted);
+      }
+
+      runner.run(recompiled, cycles);
+      requireSameState(interpreted, recompiled);
+
+      if(interpreted.awaitingKeypress) {
+        chip8::handleKeypress(interpreted, key);
+        chip8::handleKeypress(recompiled, key);
+        key = (key + 1) & 0xF;
+      } else if(slice % 5 == 0) {
+        chip8::handleKeypress(interpreted, key);
+        chip8::handleKeypress(recompiled, key);
+      } else if(slice % 5 == 3) {
+        chip8::handleKeyRelease(interpreted, key);
+        chip8::handleKeyRelease(recompiled, key);
+      }
+
+      chip8::updateTimers(interpreted);
+      chip8::updateTimers(recompiled);
+    }
+
+    REQUIRE( runner.isUsingBlocks() );
+  }
+
+}
+
+TEST_CASE( "Recompiled roms", "generated blocks and RecompiledRunner" ) {
+  SECTION( "recompiled brix runs exactly like the interpreter" ) {
+    requireMatchesInterpreter(RECOMPILED_BRIX, "brix.chip8");
+  }
+
+  SECTION( "recompiled pong runs exactly like the interpreter" ) {
+    requireMatchesInterpreter(RECOMPILED_PONG, "pong.chip8");
+  }
+
+  SECTION( "the generated rom describes its code" ) {
+    REQUIRE( std::string{RECOMPILED_BRIX.name} == "RECOMPILED_BRIX" );
+    REQUIRE( !RECOMPILED_BRIX.xoChip );
+    REQUIRE( RECOMPILED_BRIX.firstAddress == chip8::PROGRAM_START_ADDRESS );
+    REQUIRE( RECOMPILED_BRIX.blocks[0] );
+    REQUIRE( RECOMPILED_BRIX.blocks[0]->start == chip8::PROGRAM_START_ADDRESS );
+    REQUIRE( !RECOMPILED_BRIX.blocks[1] );
+
+    REQUIRE( chip8::touchesCode(RECOMPILED_BRIX, 0x200, 1) );
+    REQUIRE( chip8::touchesCode(RECOMPILED_BRIX, 0x1FE, 3) );
+    REQUIRE( !chip8::touchesCode(RECOMPILED_BRIX, 0x1FD, 3) );
+    REQUIRE( !chip8::touchesCode(RECOMPILED_BRIX, RECOMPILED_BRIX.endAddress, 3) );
+  }
+
+  SECTION( "a VM without the rom's code falls back to the interpreter" ) {
+    chip8::VirtualMachine vm;
+    loadRom(vm, "pong.chip8");
+
+    chip8::RecompiledRunner runner{RECOMPILED_BRIX, vm};
+
+    REQUIRE( !runner.isUsingBlocks() );
+
+    chip8::VirtualMachine xoChip;
+    chip8::enableXoChip(xoChip);
+    loadRom(xoChip, "brix.chip8");
+
+    REQUIRE( !chip8::matchesCode(RECOMPILED_BRIX, xoChip) );
+  }
+
+  SECTION( "a store over code stops the blocks from being used" ) {
+    chip8::VirtualMachine interpreted;
+    chip8::VirtualMachine recompiled;
+
+    // Past brix: I = 0x200, store V0 and V1 there, turning brix's first
+    // instruction from 6E05 into 6E07, then jump into brix.
+    const std::vector<chip8::Byte> patch { 0xA2, 0x00, 0xF1, 0x55, 0x12, 0x00 };
+
+    for(auto vm : { &interpreted, &recompiled }) {
+      loadRom(*vm, "brix.chip8");
+      std::copy(patch.begin(), patch.end(), vm->memory.begin() + 0x400);
+      vm->registers[0] = 0x6E;
+      vm->registers[1] = 0x07;
+      vm->programCounter = 0x400;
+    }
+
+    chip8::RecompiledRunner runner{RECOMPILED_BRIX, recompiled};
+
+    REQUIRE( runner.isUsingBlocks() );
+
+    for(std::size_t i = 0; i < 2; i++) {
+      chip8::cycle(interpreted);
+    }
+
+    runner.run(recompiled, 2);
+
+    REQUIRE( !runner.isUsingBlocks() );
+
+    for(std::size_t i = 0; i < 200; i++) {
+      chip8::cycle(interpreted);
+    }
+
+    runner.run(recompiled, 200);
+    requireSameState(interpreted, recompiled);
+  }
+
+  SECTION( "a store over code that ends its block stops the blocks from being used" ) {
+    chip8::VirtualMachine interpreted;
+    chip8::VirtualMachine recompiled;
+
+    for(auto vm : { &interpreted, &recompiled }) {
+      REQUIRE( host::loadRomFile(*vm, std::string{CHIP8_TEST_ROMS_DIR} + "/store-over-code.chip8") == chip8::LoadStatus::Loaded );
+      chip8::reset(*vm);
+    }
+
+    chip8::RecompiledRunner runner{RECOMPILED_STORE_OVER_CODE, recompiled};
+
+    REQUIRE( runner.isUsingBlocks() );
+
+    for(std::size_t i = 0; i < 20; i++) {
+      chip8::cycle(interpreted);
+    }
+
+    runner.run(recompiled, 20);
+
+    REQUIRE( interpreted.registers[2] == 7 );
+    REQUIRE( !runner.isUsingBlocks() );
+    requireSameState(interpreted, recompiled);
+  }
+
+  SECTION( "writeRecompiledRom lifts simple instructions in place" ) {
+    chip8::Memory memory(chip8::RAM_SIZE, 0);
+    const std::vector<chip8::Byte> program { 0x60, 0x05, 0x71, 0x02, 0xA3, 0x00, 0xD0, 0x15, 0x30, 0x07, 0x12, 0x00, 0x12, 0x02 };
+
+    std::copy(program.begin(), program.end(), memory.begin() + chip8::PROGRAM_START_ADDRESS);
+
+    const auto graph = chip8::buildControlFlowGraph(memory);
+    std::ostringstream out;
+
+    chip8::writeRecompiledRom(graph, memory, "TEST_ROM", out);
+
+    const auto source = out.str();
+
+    REQUIRE( source.find("const chip8::RecompiledRom TEST_ROM {") != std::string::npos );
+    REQUIRE( source.find("RecompiledBlockResult block0x200(VirtualMachine & vm) {") != std::string::npos );
+    REQUIRE( source.find("vm.registers[0x0] = 0x05;") != std::string::npos );
+    REQUIRE( source.find("vm.registers[0x1] += 0x02;") != std::string::npos );
+    REQUIRE( source.find("vm.I = 0x300;") != std::string::npos );
+    REQUIRE( source.find("ops::blit(vm, 0xD015);") != std::string::npos );
+    REQUIRE( source.find("vm.programCounter = (vm.registers[0x0] == 0x07) ? 0x20C : 0x20A;") != std::string::npos );
+  }
+
+  SECTION( "a rom with no reachable code can't be recompiled" ) {
+    chip8::ControlFlowGraph graph;
+    chip8::Memory memory(chip8::RAM_SIZE, 0);
+    std::ostringstream out;
+
+    REQUIRE_THROWS_AS(chip8::writeRecompiledRom(graph, memory, "EMPTY", out), const std::runtime_error &);
+  }
+}
\ No newline at end of file
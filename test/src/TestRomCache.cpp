@@ -0,0 +1,146 @@
+#include "catch.hpp"
+#include "chip8/Constants.hpp"
+#include "chip8/Functions.hpp"
+#include "chip8/VirtualMachine.hpp"
+#include "host/RomCache.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+  const std::string FIRST_PATH = "chip8-test-cache-a.chip8";
+  const std::string SECOND_PATH = "chip8-test-cache-b.chip8";
+
+  void writeRom(const std::string & path, const std::vector<char> & data) {
+    std::ofstream file{path, std::ios::binary};
+    file.write(data.data(), data.size());
+  }
+
+}
+
+TEST_CASE( "Memory images", "a VM's whole initial memory in one copy" ) {
+  const std::vector<char> rom { 0x12, 0x34, static_cast<char>(0xAB) };
+  const auto image = chip8::buildMemoryImage(rom.data(), rom.size());
+
+  SECTION( "a new VM's memory holds both fonts and nothing else" ) {
+    const chip8::VirtualMachine vm;
+
+    REQUIRE( std::equal(chip8::FONT_DATA.begin(), chip8::FONT_DATA.end(), vm.memory.begin() + chip8::FONT_ADDRESS) );
+    REQUIRE( std::equal(chip8::BIG_FONT_DATA.begin(), chip8::BIG_FONT_DATA.end(), vm.memory.begin() + chip8::BIG_FONT_ADDRESS) );
+    REQUIRE( std::all_of(vm.memory.begin() + chip8::BIG_FONT_ADDRESS + chip8::BIG_FONT_DATA.size(), vm.memory.end(),
+      [](chip8::Byte b) { return b == 0; }) );
+    REQUIRE( vm.memory.size() == chip8::INITIAL_MEMORY.size() );
+  }
+
+  SECTION( "buildMemoryImage puts the fonts before the rom" ) {
+    REQUIRE( image.size() == chip8::PROGRAM_START_ADDRESS + rom.size() );
+    REQUIRE( std::equal(chip8::FONT_DATA.begin(), chip8::FONT_DATA.end(), image.begin()) );
+    REQUIRE( std::equal(chip8::BIG_FONT_DATA.begin(), chip8::BIG_FONT_DATA.end(), image.begin() + chip8::BIG_FONT_ADDRESS) );
+    REQUIRE( image[chip8::BIG_FONT_ADDRESS + chip8::BIG_FONT_DATA.size()] == 0 );
+    REQUIRE( image[chip8::PROGRAM_START_ADDRESS + 2] == 0xAB );
+  }
+
+  SECTION( "loadMemoryImage matches loading the font and rom separately" ) {
+    chip8::VirtualMachine expected;
+    chip8::loadFontData(expected, chip8::FONT_DATA);
+    chip8::loadRomData(expected, rom);
+
+    chip8::VirtualMachine vm;
+    std::fill(vm.memory.begin(), vm.memory.end(), 0xEE);
+
+    REQUIRE( chip8::loadMemoryImage(vm, image) == chip8::LoadStatus::Loaded );
+    REQUIRE( (vm.memory == expected.memory) );
+  }
+
+  SECTION( "loadMemoryImage rejects images without a rom or too large for memory" ) {
+    chip8::VirtualMachine vm;
+    const chip8::Memory fontOnly(chip8::PROGRAM_START_ADDRESS, 0);
+    const chip8::Memory tooLarge(chip8::RAM_SIZE + 1, 0);
+
+    REQUIRE( chip8::loadMemoryImage(vm, fontOnly) == chip8::LoadStatus::Empty );
+    REQUIRE( chip8::loadMemoryImage(vm, tooLarge) == chip8::LoadStatus::TooLarge );
+
+    chip8::enableXoChip(vm);
+
+    REQUIRE( chip8::loadMemoryImage(vm, tooLarge) == chip8::LoadStatus::Loaded );
+  }
+}
+
+TEST_CASE( "Rom cache", "each rom is loaded and stored once" ) {
+  host::RomCache cache;
+  const std::vector<char> rom { 0x60, 0x01, 0x12, 0x00 };
+
+  SECTION( "roms with the same contents share an image, whatever their path" ) {
+    writeRom(FIRST_PATH, rom);
+    writeRom(SECOND_PATH, rom);
+
+    host::RomImage first;
+    host::RomImage second;
+
+    REQUIRE( cache.get(FIRST_PATH, first) == chip8::LoadStatus::Loaded );
+    REQUIRE( cache.get(SECOND_PATH, second) == chip8::LoadStatus::Loaded );
+    REQUIRE( first.get() == second.get() );
+
+    host::RomImage fromMemory;
+    REQUIRE( cache.get(rom.data(), rom.size(), fromMemory) == chip8::LoadStatus::Loaded );
+    REQUIRE( fromMemory.get() == first.get() );
+    REQUIRE( cache.size() == 1 );
+    REQUIRE( (*first)[chip8::PROGRAM_START_ADDRESS] == 0x60 );
+
+    std::remove(FIRST_PATH.c_str());
+    std::remove(SECOND_PATH.c_str());
+  }
+
+  SECTION( "a path is only read the first time it's asked for" ) {
+    writeRom(FIRST_PATH, rom);
+
+    host::RomImage before;
+    REQUIRE( cache.get(FIRST_PATH, before) == chip8::LoadStatus::Loaded );
+
+    writeRom(FIRST_PATH, std::vector<char>{ 0x00, static_cast<char>(0xE0) });
+
+    host::RomImage after;
+    REQUIRE( cache.get(FIRST_PATH, after) == chip8::LoadStatus::Loaded );
+    REQUIRE( after.get() == before.get() );
+
+    std::remove(FIRST_PATH.c_str());
+  }
+
+  SECTION( "different roms get different images" ) {
+    const std::vector<char> other { 0x60, 0x02, 0x12, 0x00 };
+    host::RomImage first;
+    host::RomImage second;
+
+    cache.get(rom.data(), rom.size(), first);
+    cache.get(other.data(), other.size(), second);
+
+    REQUIRE( first.get() != second.get() );
+    REQUIRE( cache.size() == 2 );
+  }
+
+  SECTION( "failures are reported and not cached" ) {
+    host::RomImage image;
+
+    REQUIRE( cache.get("no-such-rom.chip8", image) == chip8::LoadStatus::CannotOpen );
+
+    writeRom(FIRST_PATH, std::vector<char>{});
+    REQUIRE( cache.get(FIRST_PATH, image) == chip8::LoadStatus::Empty );
+
+    // Even XO-CHIP's memory can't hold a rom this large.
+    const std::vector<char> tooLarge(chip8::XO_CHIP_RAM_SIZE - chip8::PROGRAM_START_ADDRESS + 1, 0);
+    writeRom(FIRST_PATH, tooLarge);
+    REQUIRE( cache.get(FIRST_PATH, image) == chip8::LoadStatus::TooLarge );
+    REQUIRE( cache.get(tooLarge.data(), tooLarge.size(), image) == chip8::LoadStatus::TooLarge );
+    REQUIRE( cache.get(nullptr, 0, image) == chip8::LoadStatus::Empty );
+    REQUIRE( !image );
+
+    writeRom(FIRST_PATH, rom);
+    REQUIRE( cache.get(FIRST_PATH, image) == chip8::LoadStatus::Loaded );
+    REQUIRE( cache.size() == 1 );
+
+    std::remove(FIRST_PATH.c_str());
+  }
+}
\ No newline at end of file
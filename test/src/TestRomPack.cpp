@@ -0,0 +1,108 @@
+#include "catch.hpp"
+#include "chip8/Constants.hpp"
+#include "chip8/Functions.hpp"
+#include "chip8/VirtualMachine.hpp"
+#include "host/RomPack.hpp"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+  const std::string PACK_PATH = "chip8-test-pack.c8pk";
+
+  void writeFile(const std::string & contents) {
+    std::ofstream file{PACK_PATH, std::ios::binary};
+    file.write(contents.data(), contents.size());
+  }
+
+  std::string packOf(const std::vector<std::vector<char>> & roms) {
+    std::vector<host::RomSpan> spans;
+
+    for(const auto & rom : roms) {
+      spans.push_back(host::RomSpan{ rom.data(), rom.size() });
+    }
+
+    std::ostringstream out;
+    host::writeRomPack(out, spans);
+
+    return out.str();
+  }
+
+}
+
+TEST_CASE( "Rom packs", "many roms in one indexed file" ) {
+  const std::vector<std::vector<char>> roms {
+    { 0x60, 0x01 },
+    { },
+    { 0x12, 0x34, static_cast<char>(0xAB) }
+  };
+
+  SECTION( "writeRomPack lays out a header, an offset table and the roms" ) {
+    const auto pack = packOf(roms);
+
+    REQUIRE( pack.size() == host::ROM_PACK_HEADER_SIZE + 4 * host::ROM_PACK_OFFSET_SIZE + 5 );
+    REQUIRE( pack.compare(0, 4, "C8PK") == 0 );
+    REQUIRE( pack[8] == 3 );
+    REQUIRE( pack[host::ROM_PACK_HEADER_SIZE] == 48 );
+    REQUIRE( pack.back() == static_cast<char>(0xAB) );
+  }
+
+  SECTION( "RomPack returns each rom by index" ) {
+    writeFile(packOf(roms));
+
+    const host::RomPack pack{PACK_PATH};
+
+    REQUIRE( pack.size() == 3 );
+    REQUIRE( pack.getRom(0).size == 2 );
+    REQUIRE( pack.getRom(0).data[1] == 0x01 );
+    REQUIRE( pack.getRom(1).size == 0 );
+    REQUIRE( pack.getRom(2).size == 3 );
+    REQUIRE( pack.getRom(2).data[0] == 0x12 );
+    REQUIRE_THROWS_AS( pack.getRom(3), const std::runtime_error & );
+  }
+
+  SECTION( "loadRom hands the rom to loadRomData" ) {
+    writeFile(packOf(roms));
+
+    const host::RomPack pack{PACK_PATH};
+    chip8::VirtualMachine vm;
+
+    REQUIRE( pack.loadRom(vm, 2) == chip8::LoadStatus::Loaded );
+    REQUIRE( vm.memory[chip8::PROGRAM_START_ADDRESS + 2] == 0xAB );
+    REQUIRE( pack.loadRom(vm, 1) == chip8::LoadStatus::Empty );
+  }
+
+  SECTION( "an empty pack is valid" ) {
+    writeFile(packOf({}));
+
+    const host::RomPack pack{PACK_PATH};
+
+    REQUIRE( pack.size() == 0 );
+  }
+
+  SECTION( "RomPack rejects missing, foreign, truncated and corrupt files" ) {
+    REQUIRE_THROWS_AS( host::RomPack{"no-such-pack.c8pk"}, const std::runtime_error & );
+
+    writeFile("not a rom pack at all");
+    REQUIRE_THROWS_AS( host::RomPack{PACK_PATH}, const std::runtime_error & );
+
+    const auto pack = packOf(roms);
+
+    writeFile(pack.substr(0, host::ROM_PACK_HEADER_SIZE + host::ROM_PACK_OFFSET_SIZE));
+    REQUIRE_THROWS_AS( host::RomPack{PACK_PATH}, const std::runtime_error & );
+
+    writeFile(pack.substr(0, pack.size() - 1));
+    REQUIRE_THROWS_AS( host::RomPack{PACK_PATH}, const std::runtime_error & );
+
+    auto unordered = pack;
+    unordered[host::ROM_PACK_HEADER_SIZE + host::ROM_PACK_OFFSET_SIZE] = 0x40;
+    writeFile(unordered);
+    REQUIRE_THROWS_AS( host::RomPack{PACK_PATH}, const std::runtime_error & );
+  }
+
+  std::remove(PACK_PATH.c_str());
+}
\ No newline at end of file
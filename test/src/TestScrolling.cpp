@@ -0,0 +1,96 @@
+#include "catch.hpp"
+#include "chip8/Scrolling.hpp"
+#include <cstdint>
+
+namespace {
+  // Fills a plane with a deterministic, dense pattern so every bit position
+  // is exercised.
+  std::uint64_t nextPattern(std::uint64_t & seed) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return seed ^ (seed >> 31);
+  }
+
+  void fillPattern(chip8::GraphicsBuffer & plane, std::uint64_t seed) {
+    for(auto & row : plane) {
+      row = nextPattern(seed);
+    }
+  }
+
+  void fillPattern(chip8::HiResGraphicsBuffer & plane, std::uint64_t seed) {
+    for(auto & row : plane) {
+      row[0] = nextPattern(seed);
+      row[1] = nextPattern(seed);
+    }
+  }
+}
+
+TEST_CASE( "Plane scrolling", "vectorised scrolls match the scalar reference" ) {
+
+  SECTION( "scrollPlaneRight and scrollPlaneLeft match the scalar reference for every pixel count in low resolution" ) {
+    for(unsigned int pixels = 0; pixels < 64; pixels++) {
+      chip8::GraphicsBuffer expected, actual;
+      fillPattern(expected, pixels + 1);
+      fillPattern(actual, pixels + 1);
+
+      chip8::scalar::scrollPlaneRight(expected, pixels);
+      chip8::scrollPlaneRight(actual, pixels);
+
+      REQUIRE( actual == expected );
+
+      chip8::scalar::scrollPlaneLeft(expected, pixels);
+      chip8::scrollPlaneLeft(actual, pixels);
+
+      REQUIRE( actual == expected );
+    }
+  }
+
+  SECTION( "scrollPlaneRight and scrollPlaneLeft match the scalar reference for every pixel count in high resolution" ) {
+    for(unsigned int pixels = 0; pixels < 64; pixels++) {
+      chip8::HiResGraphicsBuffer expected, actual;
+      fillPattern(expected, pixels + 1);
+      fillPattern(actual, pixels + 1);
+
+      chip8::scalar::scrollPlaneRight(expected, pixels);
+      chip8::scrollPlaneRight(actual, pixels);
+
+      REQUIRE( actual == expected );
+
+      chip8::scalar::scrollPlaneLeft(expected, pixels);
+      chip8::scrollPlaneLeft(actual, pixels);
+
+      REQUIRE( actual == expected );
+    }
+  }
+
+  SECTION( "scrollPlaneRight carries pixels from the left word into the right word" ) {
+    chip8::HiResGraphicsBuffer plane;
+    fillPattern(plane, 0);
+    plane[7][0] = 0x00000000000000FF;
+    plane[7][1] = 0;
+
+    chip8::scrollPlaneRight(plane, 4);
+
+    REQUIRE( plane[7][0] == 0x000000000000000F );
+    REQUIRE( plane[7][1] == 0xF000000000000000 );
+  }
+
+  SECTION( "scrollPlaneDown and scrollPlaneUp move rows and clear the exposed ones" ) {
+    chip8::HiResGraphicsBuffer plane;
+    fillPattern(plane, 42);
+    const auto original = plane;
+
+    chip8::scrollPlaneDown(plane, 5);
+
+    REQUIRE( plane[4][0] == 0 );
+    REQUIRE( plane[4][1] == 0 );
+    REQUIRE( plane[5] == original[0] );
+    REQUIRE( plane[63] == original[58] );
+
+    chip8::scrollPlaneUp(plane, 5);
+
+    REQUIRE( plane[0] == original[0] );
+    REQUIRE( plane[58] == original[58] );
+    REQUIRE( plane[59][0] == 0 );
+    REQUIRE( plane[63][1] == 0 );
+  }
+}
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include "catch.hpp"
+#include "host/GatedTone.hpp"
+#include "host/SpscQueue.hpp"
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+  // Index of the first non-silent frame at or after from, or frames.
+  std::size_t firstSounding(const std::vector<std::int8_t> & samples, std::size_t from = 0) {
+    while(from < samples.size() && samples[from] == 0) {
+      from++;
+    }
+
+    return from;
+  }
+
+  // Index of the first silent frame at or after from, or frames.
+  std::size_t firstSilent(const std::vector<std::int8_t> & samples, std::size_t from = 0) {
+    while(from < samples.size() && samples[from] != 0) {
+      from++;
+    }
+
+    return from;
+  }
+
+}
+
+TEST_CASE( "Single producer, single consumer queue", "lock-free event hand-off" ) {
+
+  SECTION( "items come out in the order they went in" ) {
+    host::SpscQueue<int, 4> queue;
+    int item = 0;
+
+    REQUIRE( queue.empty() );
+    REQUIRE( queue.push(1) );
+    REQUIRE( queue.push(2) );
+    REQUIRE( queue.pop(item) );
+    REQUIRE( item == 1 );
+    REQUIRE( queue.push(3) );
+    REQUIRE( queue.pop(item) );
+    REQUIRE( item == 2 );
+    REQUIRE( queue.pop(item) );
+    REQUIRE( item == 3 );
+    REQUIRE( queue.empty() );
+  }
+
+  SECTION( "push fails when full and pop fails when empty" ) {
+    host::SpscQueue<int, 4> queue;
+    int item = 0;
+
+    REQUIRE_FALSE( queue.pop(item) );
+
+    for(int i = 0; i < 4; i++) {
+      REQUIRE( queue.push(i) );
+    }
+
+    REQUIRE_FALSE( queue.push(4) );
+    REQUIRE( queue.pop(item) );
+    REQUIRE( item == 0 );
+    REQUIRE( queue.push(4) );
+  }
+
+  SECTION( "peek leaves the item in place" ) {
+    host::SpscQueue<int, 4> queue;
+    int item = 0;
+
+    queue.push(7);
+
+    REQUIRE( queue.peek(item) );
+    REQUIRE( item == 7 );
+    REQUIRE_FALSE( queue.empty() );
+    REQUIRE( queue.pop(item) );
+    REQUIRE( queue.empty() );
+  }
+
+  SECTION( "every item crosses between threads exactly once and in order" ) {
+    const int count = 100000;
+    host::SpscQueue<int, 64> queue;
+
+    std::thread producer([&queue, count]() {
+      for(int i = 0; i < count; i++) {
+        while(!queue.push(i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    int expected = 0;
+    bool ordered = true;
+
+    while(expected < count) {
+      int item = 0;
+
+      if(queue.pop(item)) {
+        ordered = ordered && item == expected;
+        expected++;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+
+    producer.join();
+
+    REQUIRE( ordered );
+    REQUIRE( queue.empty() );
+  }
+}
+
+TEST_CASE( "Gated tone", "sample-accurate sound timer gating" ) {
+
+  SECTION( "renders silence until an event switches the tone on" ) {
+    host::GatedTone tone{48000, 120.0, 5, 1024};
+    std::vector<std::int8_t> samples(512);
+
+    tone.render(samples.data(), samples.size(), 1);
+
+    REQUIRE( firstSounding(samples) == samples.size() );
+    REQUIRE_FALSE( tone.isSounding() );
+    REQUIRE( tone.getFramesRendered() == 512 );
+  }
+
+  SECTION( "events switch the tone on the exact frame they name" ) {
+    host::GatedTone tone{48000, 120.0, 5, 1024};
+    std::vector<std::int8_t> samples(512);
+
+    tone.push(host::SoundEvent{100, true});
+    tone.push(host::SoundEvent{300, false});
+    tone.render(samples.data(), samples.size(), 1);
+
+    REQUIRE( firstSounding(samples) == 100 );
+    REQUIRE( firstSilent(samples, 100) == 300 );
+    REQUIRE( firstSounding(samples, 300) == samples.size() );
+  }
+
+  SECTION( "events past the end of a buffer wait for the buffer they fall in" ) {
+    host::GatedTone tone{48000, 120.0, 5, 1024};
+    std::vector<std::int8_t> samples(256);
+
+    tone.push(host::SoundEvent{300, true});
+    tone.render(samples.data(), samples.size(), 1);
+
+    REQUIRE( firstSounding(samples) == samples.size() );
+
+    tone.render(samples.data(), samples.size(), 1);
+
+    REQUIRE( firstSounding(samples) == 300 - 256 );
+    REQUIRE( firstSilent(samples, 300 - 256) == samples.size() );
+    REQUIRE( tone.isSounding() );
+  }
+
+  SECTION( "events already in the past apply at the start of the buffer" ) {
+    host::GatedTone tone{48000, 120.0, 5, 1024};
+    std::vector<std::int8_t> samples(256);
+
+    tone.render(samples.data(), samples.size(), 1);
+    tone.push(host::SoundEvent{10, true});
+    tone.render(samples.data(), samples.size(), 1);
+
+    REQUIRE( firstSounding(samples) == 0 );
+  }
+
+  SECTION( "events too far ahead are clamped to now" ) {
+    host::GatedTone tone{48000, 120.0, 5, 1024};
+    std::vector<std::int8_t> samples(256);
+
+    tone.push(host::SoundEvent{256 + 1024 + 1, true});
+    tone.render(samples.data(), samples.size(), 1);
+
+    REQUIRE( firstSounding(samples) == 0 );
+  }
+
+  SECTION( "gating applies to every channel of a frame" ) {
+    host::GatedTone tone{48000, 120.0, 5, 1024};
+    std::vector<std::int8_t> samples(256 * 2);
+
+    tone.push(host::SoundEvent{64, true});
+    tone.render(samples.data(), 256, 2);
+
+    REQUIRE( firstSounding(samples) == 64 * 2 );
+
+    for(std::size_t frame = 0; frame < 256; frame++) {
+      REQUIRE( samples[frame * 2] == samples[frame * 2 + 1] );
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#include "catch.hpp"
+#include "host/SquareWave.hpp"
+#include <cstdint>
+#include <vector>
+
+TEST_CASE( "Square wave synthesis", "table-driven tone generation" ) {
+
+  SECTION( "generate produces a square wave of the requested period and amplitude" ) {
+    // 48000 / 120 = a 400 frame period: 200 frames high, 200 frames low. The
+    // phase increment is rounded, so the edges themselves may land a frame
+    // late.
+    host::SquareWave wave{48000, 120.0, 5};
+    std::vector<std::int8_t> samples(800);
+
+    wave.generate(samples.data(), samples.size(), 1);
+
+    REQUIRE( samples[0] == 5 );
+    REQUIRE( samples[198] == 5 );
+    REQUIRE( samples[202] == -5 );
+    REQUIRE( samples[398] == -5 );
+    REQUIRE( samples[402] == 5 );
+    REQUIRE( samples[799] == -5 );
+  }
+
+  SECTION( "generate writes the same sample to every channel of a frame" ) {
+    host::SquareWave wave{48000, 120.0, 5};
+    std::vector<std::int8_t> samples(400 * 2);
+
+    wave.generate(samples.data(), 400, 2);
+
+    for(std::size_t frame = 0; frame < 400; frame++) {
+      REQUIRE( samples[frame * 2] == samples[frame * 2 + 1] );
+    }
+
+    REQUIRE( samples[2 * 198] == 5 );
+    REQUIRE( samples[2 * 202] == -5 );
+  }
+
+  SECTION( "each instance keeps its own phase, carried across calls" ) {
+    host::SquareWave first{48000, 120.0, 5};
+    host::SquareWave second{48000, 120.0, 5};
+    std::vector<std::int8_t> samples(300);
+
+    first.generate(samples.data(), 300, 1);
+
+    REQUIRE( first.getPhase() == 300 * first.getPhaseIncrement() );
+    REQUIRE( second.getPhase() == 0 );
+
+    first.generate(samples.data(), 1, 1);
+
+    REQUIRE( samples[0] == -5 ); // frame 300 falls in the low half of the period
+  }
+}
\ No newline at end of file
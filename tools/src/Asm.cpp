@@ -0,0 +1,91 @@
+#include "chip8/Assembler.hpp"
+#include "chip8/Functions.hpp"
+#include "host/FileUtilities.hpp"
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+  void printUsage() {
+    std::cerr << "Usage: chip8-asm [--origin ADDR] [--output FILE] source\n"
+              << "Assembles the source into a rom, written to FILE or standard output.\n"
+              << "Instructions are written as chip8-disasm --source writes them, with\n"
+              << "labels, EQU constants and the DB, DW and ORG directives; see\n"
+              << "include/chip8/Assembler.hpp. ADDR is where the rom is loaded, 0x200\n"
+              << "by default." << std::endl;
+  }
+
+  bool parseAddress(const std::string & text, chip8::Address & address) {
+    try {
+      std::size_t length = 0;
+      const auto value = std::stoul(text, &length, 0);
+
+      if(length != text.size() || value > 0xFFFF) {
+        return false;
+      }
+
+      address = static_cast<chip8::Address>(value);
+      return true;
+    } catch(const std::exception &) {
+      return false;
+    }
+  }
+
+}
+
+int main(int argc, char** argv) {
+  const std::vector<std::string> args(argv + 1, argv + argc);
+
+  chip8::Address origin = chip8::PROGRAM_START_ADDRESS;
+  std::string outputPath;
+  std::string sourcePath;
+
+  for(std::size_t i = 0; i < args.size(); i++) {
+    const bool hasValue = i + 1 < args.size();
+
+    if(args[i] == "--origin" && hasValue && parseAddress(args[i + 1], origin)) {
+      i++;
+    } else if(args[i] == "--output" && hasValue) {
+      outputPath = args[++i];
+    } else if(sourcePath.empty() && !args[i].empty() && args[i][0] != '-') {
+      sourcePath = args[i];
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  if(sourcePath.empty()) {
+    printUsage();
+    return 1;
+  }
+
+  std::vector<chip8::Byte> rom;
+
+  try {
+    const auto source = host::readFileAsChar(sourcePath);
+    rom = chip8::assemble(std::string(source.begin(), source.end()), origin);
+  } catch(const std::exception & e) {
+    std::cerr << sourcePath << ": " << e.what() << std::endl;
+    return 1;
+  }
+
+  std::ofstream file;
+
+  if(!outputPath.empty()) {
+    file.open(outputPath, std::ios::binary);
+
+    if(!file.is_open()) {
+      std::cerr << "Could not write " << outputPath << std::endl;
+      return 1;
+    }
+  }
+
+  std::ostream & out = outputPath.empty() ? std::cout : file;
+  out.write(reinterpret_cast<const char *>(rom.data()), rom.size());
+
+  return out ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "chip8/ControlFlow.hpp"
+#include "chip8/Functions.hpp"
+#include "chip8/VirtualMachine.hpp"
+#include "host/FileUtilities.hpp"
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+  void printUsage() {
+    std::cerr << "Usage: chip8-cfg [--json] [--xo-chip] [--output FILE] rom\n"
+              << "Follows every path through the rom from 0x200 and prints its control\n"
+              << "flow graph of basic blocks, as Graphviz DOT or with --json as JSON.\n"
+              << "Computed jumps (BNNN), stores that overwrite code and stores whose\n"
+              << "target isn't known are flagged, and listed on standard error.\n"
+              << "--xo-chip analyses the rom as XO-CHIP, with 64KB of memory and the\n"
+              << "four byte F000 NNNN." << std::endl;
+  }
+
+  void printFindings(const char * name, const std::vector<chip8::Address> & addresses) {
+    if(addresses.empty()) {
+      return;
+    }
+
+    std::cerr << name << ":" << std::hex << std::uppercase;
+
+    for(const auto address : addresses) {
+      std::cerr << " 0x" << address;
+    }
+
+    std::cerr << std::dec << std::nouppercase << std::endl;
+  }
+
+}
+
+int main(int argc, char** argv) {
+  const std::vector<std::string> args(argv + 1, argv + argc);
+
+  bool json = false;
+  bool xoChip = false;
+  std::string outputPath;
+  std::string romPath;
+
+  for(std::size_t i = 0; i < args.size(); i++) {
+    const bool hasValue = i + 1 < args.size();
+
+    if(args[i] == "--json") {
+      json = true;
+    } else if(args[i] == "--xo-chip") {
+      xoChip = true;
+    } else if(args[i] == "--output" && hasValue) {
+      outputPath = args[++i];
+    } else if(romPath.empty() && !args[i].empty() && args[i][0] != '-') {
+      romPath = args[i];
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  if(romPath.empty()) {
+    printUsage();
+    return 1;
+  }
+
+  chip8::VirtualMachine vm;
+
+  if(xoChip) {
+    chip8::enableXoChip(vm);
+  }
+
+  const auto status = host::loadRomFile(vm, romPath);
+
+  if(status != chip8::LoadStatus::Loaded) {
+    std::cerr << romPath << ": " << chip8::describe(status) << std::endl;
+    return 1;
+  }
+
+  const chip8::Memory memory(vm.memory.begin(), vm.memory.end());
+  const auto graph = chip8::buildControlFlowGraph(memory, chip8::PROGRAM_START_ADDRESS, xoChip);
+
+  std::ofstream file;
+
+  if(!outputPath.empty()) {
+    file.open(outputPath);
+
+    if(!file.is_open()) {
+      std::cerr << "Could not write " << outputPath << std::endl;
+      return 1;
+    }
+  }
+
+  std::ostream & out = outputPath.empty() ? std::cout : file;
+
+  if(json) {
+    chip8::writeJson(graph, out);
+  } else {
+    chip8::writeDot(graph, out);
+  }
+
+  std::cerr << romPath << ": " << graph.blocks.size() << " blocks, "
+            << graph.subroutines.size() << " subroutines" << std::endl;
+  printFindings("computed jumps", graph.computedJumps);
+  printFindings("self-modifying stores", graph.selfModifyingStores);
+  printFindings("unresolved stores", graph.unresolvedStores);
+
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include "chip8/Disassembler.hpp"
+#include "chip8/Functions.hpp"
+#include "host/FileUtilities.hpp"
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+  void printUsage() {
+    std::cerr << "Usage: chip8-disasm [--source] [--origin ADDR] [--output FILE] rom\n"
+              << "Lists the rom as one instruction per line, with its address and bytes,\n"
+              << "in Cowgod's syntax. Every pair of bytes is listed as an instruction,\n"
+              << "data included; chip8-cfg shows which are reachable.\n"
+              << "--source leaves out the address and byte columns and writes source\n"
+              << "that chip8-asm, given the same --origin, assembles back into the rom.\n"
+              << "ADDR is where the rom is loaded, 0x200 by default." << std::endl;
+  }
+
+  bool parseAddress(const std::string & text, chip8::Address & address) {
+    try {
+      std::size_t length = 0;
+      const auto value = std::stoul(text, &length, 0);
+
+      if(length != text.size() || value > 0xFFFF) {
+        return false;
+      }
+
+      address = static_cast<chip8::Address>(value);
+      return true;
+    } catch(const std::exception &) {
+      return false;
+    }
+  }
+
+}
+
+int main(int argc, char** argv) {
+  const std::vector<std::string> args(argv + 1, argv + argc);
+
+  bool source = false;
+  chip8::Address origin = chip8::PROGRAM_START_ADDRESS;
+  std::string outputPath;
+  std::string romPath;
+
+  for(std::size_t i = 0; i < args.size(); i++) {
+    const bool hasValue = i + 1 < args.size();
+
+    if(args[i] == "--source") {
+      source = true;
+    } else if(args[i] == "--origin" && hasValue && parseAddress(args[i + 1], origin)) {
+      i++;
+    } else if(args[i] == "--output" && hasValue) {
+      outputPath = args[++i];
+    } else if(romPath.empty() && !args[i].empty() && args[i][0] != '-') {
+      romPath = args[i];
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  if(romPath.empty()) {
+    printUsage();
+    return 1;
+  }
+
+  std::vector<char> rom;
+
+  try {
+    rom = host::readFileAsChar(romPath);
+  } catch(const std::exception & e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  // The whole listing is built in memory and written at once.
+  std::string listing;
+  const auto data = reinterpret_cast<const chip8::Byte *>(rom.data());
+
+  if(source) {
+    chip8::disassembleSource(data, rom.size(), origin, listing);
+  } else {
+    chip8::disassemble(data, rom.size(), origin, listing);
+  }
+
+  std::ofstream file;
+
+  if(!outputPath.empty()) {
+    file.open(outputPath);
+
+    if(!file.is_open()) {
+      std::cerr << "Could not write " << outputPath << std::endl;
+      return 1;
+    }
+  }
+
+  std::ostream & out = outputPath.empty() ? std::cout : file;
+  out.write(listing.data(), listing.size());
+
+  return out ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "host/FileUtilities.hpp"
+#include "host/RomPack.hpp"
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+  void printUsage() {
+    std::cerr << "Usage: chip8-pack OUTPUT.c8pk rom ...\n"
+              << "       chip8-pack OUTPUT.c8pk - < list-of-roms\n"
+              << "       chip8-pack --list PACK.c8pk\n"
+              << "Packs the roms, in the order given, into one file that chip8-headless\n"
+              << "--pack and host::RomPack can read. Roms are numbered from 0; the\n"
+              << "numbering is printed as they're packed. With -, rom paths are read one\n"
+              << "per line from standard input, for corpora too large for a command line.\n"
+              << "--list prints the size of every rom in an existing pack." << std::endl;
+  }
+
+  int listPack(const std::string & path) {
+    const host::RomPack pack{path};
+
+    for(std::size_t i = 0; i < pack.size(); i++) {
+      std::cout << i << "\t" << pack.getRom(i).size << "\n";
+    }
+
+    return 0;
+  }
+
+}
+
+int main(int argc, char** argv) {
+  const std::vector<std::string> args(argv + 1, argv + argc);
+
+  if(args.size() == 2 && args[0] == "--list") {
+    try {
+      return listPack(args[1]);
+    } catch(const std::exception & e) {
+      std::cerr << e.what() << std::endl;
+      return 1;
+    }
+  }
+
+  if(args.size() < 2 || args[0].empty() || args[0][0] == '-') {
+    printUsage();
+    return 1;
+  }
+
+  std::vector<std::string> paths(args.begin() + 1, args.end());
+
+  if(paths.size() == 1 && paths[0] == "-") {
+    paths.clear();
+
+    for(std::string line; std::getline(std::cin, line);) {
+      if(!line.empty()) {
+        paths.push_back(line);
+      }
+    }
+  }
+
+  std::vector<std::vector<char>> roms;
+  std::vector<host::RomSpan> spans;
+
+  try {
+    for(const auto & path : paths) {
+      roms.push_back(host::readFileAsChar(path));
+    }
+  } catch(const std::exception & e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  for(std::size_t i = 0; i < roms.size(); i++) {
+    spans.push_back(host::RomSpan{ roms[i].data(), roms[i].size() });
+    std::cout << i << "\t" << paths[i] << "\n";
+  }
+
+  std::ofstream output{args[0], std::ios::binary};
+
+  if(!output.is_open() || !host::writeRomPack(output, spans)) {
+    std::cerr << "Could not write " << args[0] << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
\ No newline at end of file
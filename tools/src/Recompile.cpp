@@ -0,0 +1,109 @@
+#include "chip8/ControlFlow.hpp"
+#include "chip8/Functions.hpp"
+#include "chip8/Recompiler.hpp"
+#include "chip8/VirtualMachine.hpp"
+#include "host/FileUtilities.hpp"
+#include <cctype>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+  void printUsage() {
+    std::cerr << "Usage: chip8-recompile [--xo-chip] [--name NAME] [--output FILE] rom\n"
+              << "Lifts the rom into basic blocks (see chip8-cfg) and writes C++ defining\n"
+              << "`const chip8::RecompiledRom NAME`, one function per block, to compile\n"
+              << "into a program and run with chip8::RecompiledRunner. NAME defaults to\n"
+              << "RECOMPILED_ROM.\n"
+              << "--xo-chip recompiles the rom as XO-CHIP." << std::endl;
+  }
+
+  bool isIdentifier(const std::string & name) {
+    if(name.empty() || std::isdigit(static_cast<unsigned char>(name[0]))) {
+      return false;
+    }
+
+    for(const auto c : name) {
+      if(!std::isalnum(static_cast<unsigned char>(c)) && c != '_') {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+}
+
+int main(int argc, char** argv) {
+  const std::vector<std::string> args(argv + 1, argv + argc);
+
+  bool xoChip = false;
+  std::string name = "RECOMPILED_ROM";
+  std::string outputPath;
+  std::string romPath;
+
+  for(std::size_t i = 0; i < args.size(); i++) {
+    const bool hasValue = i + 1 < args.size();
+
+    if(args[i] == "--xo-chip") {
+      xoChip = true;
+    } else if(args[i] == "--name" && hasValue) {
+      name = args[++i];
+    } else if(args[i] == "--output" && hasValue) {
+      outputPath = args[++i];
+    } else if(romPath.empty() && !args[i].empty() && args[i][0] != '-') {
+      romPath = args[i];
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  if(romPath.empty() || !isIdentifier(name)) {
+    printUsage();
+    return 1;
+  }
+
+  chip8::VirtualMachine vm;
+
+  if(xoChip) {
+    chip8::enableXoChip(vm);
+  }
+
+  const auto status = host::loadRomFile(vm, romPath);
+
+  if(status != chip8::LoadStatus::Loaded) {
+    std::cerr << romPath << ": " << chip8::describe(status) << std::endl;
+    return 1;
+  }
+
+  const chip8::Memory memory(vm.memory.begin(), vm.memory.end());
+  const auto graph = chip8::buildControlFlowGraph(memory, chip8::PROGRAM_START_ADDRESS, xoChip);
+
+  std::ofstream file;
+
+  if(!outputPath.empty()) {
+    file.open(outputPath);
+
+    if(!file.is_open()) {
+      std::cerr << "Could not write " << outputPath << std::endl;
+      return 1;
+    }
+  }
+
+  std::ostream & out = outputPath.empty() ? std::cout : file;
+
+  try {
+    chip8::writeRecompiledRom(graph, memory, name, out);
+  } catch(const std::exception & e) {
+    std::cerr << romPath << ": " << e.what() << std::endl;
+    return 1;
+  }
+
+  std::cerr << romPath << ": " << graph.blocks.size() << " blocks recompiled as " << name << std::endl;
+
+  return 0;
+}
\ No newline at end of file